@@ -0,0 +1,197 @@
+/**
+ * @file Marshal.c
+ * @authors Israfil Argos
+ * @brief A small benchmark of the requests made every frame: attach, damage,
+ * frame, and commit. These are sent over a socket pair rather than to a
+ * compositor, whose other end is simply drained, and timed both through the
+ * variadic protocol helpers and through the argument arrays @c Wayland.c now
+ * uses. This only depends upon the C standard library, the POSIX @c fcntl.h,
+ * @c sys/socket.h, @c time.h, and @c unistd.h headers, and the Wayland client
+ * header. Build it once against @c libwayland-client and once alongside @c
+ * Targets/Wire.c to compare the two.
+ * @since v0.0.0.69
+ *
+ * @copyright (c) 2025 - the Waterlily Project
+ * This source file is under the GNU General Public License v3.0. For licensing
+ * and other information, see the @c LICENSE.md file that should have come with
+ * your copy of the source code, or https://www.gnu.org/licenses/gpl-3.0.txt.
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <wayland-client.h>
+
+/**
+ * @def MARSHAL_FRAMES
+ * @brief The number of frames sent per round when none is given on the
+ * command line.
+ * @since v0.0.0.69
+ */
+#define MARSHAL_FRAMES 100000
+
+/**
+ * @def MARSHAL_ROUNDS
+ * @brief The number of rounds of each kind, of which the fastest is reported.
+ * @since v0.0.0.69
+ */
+#define MARSHAL_ROUNDS 5
+
+/**
+ * @def MARSHAL_FLUSH
+ * @brief The number of frames sent between flushes, so that the socket itself
+ * weighs little in the timings.
+ * @since v0.0.0.69
+ */
+#define MARSHAL_FLUSH 32
+
+/**
+ * @fn uint64_t now(void)
+ * @brief Get the current time.
+ * @since v0.0.0.69
+ *
+ * @return The time, in nanoseconds of the monotonic clock.
+ */
+static uint64_t now(void)
+{
+    struct timespec time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+/**
+ * @fn void frame(struct wl_surface *surface, bool array)
+ * @brief Send the requests of one frame, as a software-rendered window would.
+ * @since v0.0.0.69
+ *
+ * @param[in] surface The surface.
+ * @param[in] array Whether to send them as argument arrays, rather than
+ * through the variadic protocol helpers.
+ */
+static void frame(struct wl_surface *surface, bool array)
+{
+    struct wl_proxy *proxy = (struct wl_proxy *)surface;
+    uint32_t version = wl_proxy_get_version(proxy);
+    struct wl_callback *callback;
+    if (array)
+    {
+        // wl_surface_attach
+        (void)wl_proxy_marshal_array_flags(
+            proxy, 1, nullptr, version, 0,
+            (union wl_argument[]){{.o = nullptr}, {.i = 0}, {.i = 0}});
+        // wl_surface_damage_buffer
+        (void)wl_proxy_marshal_array_flags(
+            proxy, 9, nullptr, version, 0,
+            (union wl_argument[]){
+                {.i = 0}, {.i = 0}, {.i = INT32_MAX}, {.i = INT32_MAX}});
+        // wl_surface_frame
+        callback = (struct wl_callback *)wl_proxy_marshal_array_flags(
+            proxy, 3, &wl_callback_interface, version, 0,
+            (union wl_argument[]){{.n = 0}});
+        // wl_surface_commit, which takes no arguments
+        (void)wl_proxy_marshal_array_flags(
+            proxy, 6, nullptr, version, 0, (union wl_argument[1]){{.u = 0}});
+    }
+    else
+    {
+        wl_surface_attach(surface, nullptr, 0, 0);
+        wl_surface_damage_buffer(surface, 0, 0, INT32_MAX, INT32_MAX);
+        callback = wl_surface_frame(surface);
+        wl_surface_commit(surface);
+    }
+    // Just as the frame listener would, once it fired.
+    if (callback != nullptr) wl_callback_destroy(callback);
+}
+
+/**
+ * @fn uint64_t measure(struct wl_display *display, struct wl_surface
+ * *surface, int peer, size_t frames, bool array)
+ * @brief Send some number of frames, flushing every @ref MARSHAL_FLUSH of
+ * them and draining the other end of the socket.
+ * @since v0.0.0.69
+ *
+ * @param[in] display The display.
+ * @param[in] surface The surface.
+ * @param[in] peer The other end of the socket.
+ * @param[in] frames The number of frames.
+ * @param[in] array See @ref frame.
+ * @return The time taken per frame, in nanoseconds.
+ */
+static uint64_t measure(struct wl_display *display, struct wl_surface *surface,
+                        int peer, size_t frames, bool array)
+{
+    char sink[4096];
+    uint64_t start = now();
+    for (size_t i = 1; i <= frames; ++i)
+    {
+        frame(surface, array);
+        if (i % MARSHAL_FLUSH != 0 && i != frames) continue;
+
+        (void)wl_display_flush(display);
+        while (read(peer, sink, sizeof(sink)) > 0);
+    }
+    return (now() - start) / frames;
+}
+
+int main(int argc, char **argv)
+{
+    size_t frames = MARSHAL_FRAMES;
+    if (argc > 1) frames = strtoul(argv[1], nullptr, 10);
+    if (frames == 0)
+    {
+        (void)fprintf(stderr, "Usage: %s [frames]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The client library is handed its end of the pair as though it had been
+    // launched by a compositor; nothing ever answers it.
+    int fds[2];
+    char name[16];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1 ||
+        fcntl(fds[1], F_SETFL, O_NONBLOCK) == -1)
+    {
+        (void)fprintf(stderr, "Failed to create the socket pair.\n");
+        return EXIT_FAILURE;
+    }
+    (void)snprintf(name, sizeof(name), "%d", fds[0]);
+    (void)setenv("WAYLAND_SOCKET", name, 1);
+
+    struct wl_display *display = wl_display_connect(nullptr);
+    if (display == nullptr)
+    {
+        (void)fprintf(stderr, "Failed to connect over the socket pair.\n");
+        return EXIT_FAILURE;
+    }
+    struct wl_registry *registry = wl_display_get_registry(display);
+    struct wl_compositor *compositor =
+        wl_registry_bind(registry, 1, &wl_compositor_interface, 4);
+    struct wl_surface *surface = wl_compositor_create_surface(compositor);
+
+    uint64_t variadic = UINT64_MAX, array = UINT64_MAX;
+    for (size_t i = 0; i < MARSHAL_ROUNDS; ++i)
+    {
+        uint64_t time = measure(display, surface, fds[1], frames, false);
+        if (time < variadic) variadic = time;
+        time = measure(display, surface, fds[1], frames, true);
+        if (time < array) array = time;
+    }
+
+    (void)printf("%zu frames of attach, damage, frame, and commit, in "
+                 "nanoseconds per frame, best of %d.\n",
+                 frames, MARSHAL_ROUNDS);
+    (void)printf("%-10s %10llu\n", "variadic", (unsigned long long)variadic);
+    (void)printf("%-10s %10llu\n", "array", (unsigned long long)array);
+
+    wl_surface_destroy(surface);
+    wl_compositor_destroy(compositor);
+    wl_registry_destroy(registry);
+    wl_display_disconnect(display);
+    (void)close(fds[1]);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file Startup.c
+ * @authors Israfil Argos
+ * @brief A small benchmark of the time to first frame. This creates the window
+ * and presents a single software frame some number of times, then reports
+ * each phase of @ref hyacinth_create, as told by @ref hyacinth_getStartup,
+ * the time from creation to that frame being shown, and the whole, as the
+ * minimum, median, and maximum over every run. This only depends upon the C
+ * standard library, the POSIX @c sys/wait.h, @c time.h, and @c unistd.h
+ * headers, and the Hyacinth header. Build it alongside a target, e.g. @c
+ * Targets/Wayland.c.
+ * @since v0.0.0.69
+ *
+ * @copyright (c) 2025 - the Waterlily Project
+ * This source file is under the GNU General Public License v3.0. For licensing
+ * and other information, see the @c LICENSE.md file that should have come with
+ * your copy of the source code, or https://www.gnu.org/licenses/gpl-3.0.txt.
+ */
+
+#define _GNU_SOURCE
+
+#include <Hyacinth.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @def STARTUP_RUNS
+ * @brief The number of runs made when none is given on the command line.
+ * @since v0.0.0.69
+ */
+#define STARTUP_RUNS 20
+
+/**
+ * @def STARTUP_MAX
+ * @brief The most runs that can be made at once.
+ * @since v0.0.0.69
+ */
+#define STARTUP_MAX 1000
+
+/**
+ * @struct timings Startup.c "Benchmarks/Startup.c"
+ * @brief The timings of a single run, in nanoseconds.
+ * @since v0.0.0.69
+ */
+struct timings
+{
+    /**
+     * @property startup
+     * @brief The phases of creation.
+     * @since v0.0.0.69
+     */
+    hyacinth_startup startup;
+    /**
+     * @property frame
+     * @brief The time from creation returning to the first frame being shown.
+     * @since v0.0.0.69
+     */
+    uint64_t frame;
+    /**
+     * @property first
+     * @brief The time from the start of creation to the first frame being
+     * shown.
+     * @since v0.0.0.69
+     */
+    uint64_t first;
+};
+
+/**
+ * @fn uint64_t now(void)
+ * @brief Get the current time.
+ * @since v0.0.0.69
+ *
+ * @return The time, in nanoseconds of the monotonic clock.
+ */
+static uint64_t now(void)
+{
+    struct timespec time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
+/**
+ * @fn bool firstFrame(void)
+ * @brief Draw a single blank frame, present it, and wait for the compositor
+ * to say it's been shown.
+ * @since v0.0.0.69
+ *
+ * @return Whether or not the frame was shown.
+ */
+static bool firstFrame(void)
+{
+    hyacinth_buffer buffer;
+    if (!hyacinth_acquireBuffer(&buffer)) return false;
+    memset(buffer.pixels, 0, (size_t)buffer.stride * buffer.height);
+
+    // The callback fires once the frame it was committed with is shown.
+    if (!hyacinth_requestFrame() || !hyacinth_present()) return false;
+    return hyacinth_waitFrame(nullptr);
+}
+
+/**
+ * @fn bool run(struct timings *timings)
+ * @brief Create the window and show its first frame once, in a process of its
+ * own. The window can only be created once per process, and a fresh process
+ * is exactly what an application starts from anyway.
+ * @since v0.0.0.69
+ *
+ * @param[out] timings The timings of the run.
+ * @return Whether or not the window was created and its frame shown.
+ */
+static bool run(struct timings *timings)
+{
+    int fds[2];
+    if (pipe(fds) == -1) return false;
+
+    pid_t child = fork();
+    if (child == -1)
+    {
+        (void)close(fds[0]);
+        (void)close(fds[1]);
+        return false;
+    }
+    if (child == 0)
+    {
+        (void)close(fds[0]);
+        uint64_t start = now();
+        if (!hyacinth_create("Startup")) _exit(EXIT_FAILURE);
+        uint64_t created = now();
+        bool shown = firstFrame();
+        uint64_t end = now();
+        hyacinth_getStartup(&timings->startup);
+        hyacinth_destroy();
+
+        timings->frame = end - created;
+        timings->first = end - start;
+        bool sent = shown && write(fds[1], timings, sizeof(*timings)) ==
+                                 (ssize_t)sizeof(*timings);
+        _exit(sent ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    (void)close(fds[1]);
+    bool received =
+        read(fds[0], timings, sizeof(*timings)) == (ssize_t)sizeof(*timings);
+    (void)close(fds[0]);
+
+    int status;
+    if (waitpid(child, &status, 0) == -1) return false;
+    return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @fn int compare(const void *a, const void *b)
+ * @brief Order two timings, for @c qsort.
+ * @since v0.0.0.69
+ *
+ * @param[in] a The first timing.
+ * @param[in] b The second timing.
+ * @return Less than, equal to, or greater than zero as @p a is to @p b.
+ */
+static int compare(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *)a, right = *(const uint64_t *)b;
+    return (left > right) - (left < right);
+}
+
+/**
+ * @fn void report(const char *name, uint64_t *times, size_t count)
+ * @brief Print the minimum, median, and maximum of a phase, in microseconds.
+ * @since v0.0.0.69
+ *
+ * @param[in] name The name of the phase.
+ * @param[in,out] times The timings of the phase, in nanoseconds, which are
+ * sorted in place.
+ * @param[in] count The number of timings.
+ */
+static void report(const char *name, uint64_t *times, size_t count)
+{
+    qsort(times, count, sizeof(uint64_t), &compare);
+    (void)printf("%-10s %10.1f %10.1f %10.1f\n", name,
+                 (double)times[0] / 1000, (double)times[count / 2] / 1000,
+                 (double)times[count - 1] / 1000);
+}
+
+int main(int argc, char **argv)
+{
+    size_t runs = STARTUP_RUNS;
+    if (argc > 1) runs = strtoul(argv[1], nullptr, 10);
+    if (runs == 0 || runs > STARTUP_MAX)
+    {
+        (void)fprintf(stderr, "Usage: %s [runs, 1 to %d]\n", argv[0],
+                      STARTUP_MAX);
+        return EXIT_FAILURE;
+    }
+
+    static uint64_t phases[7][STARTUP_MAX];
+    for (size_t i = 0; i < runs; ++i)
+    {
+        struct timings timings;
+        if (!run(&timings))
+        {
+            (void)fprintf(stderr, "Run %zu failed to show the window.\n",
+                          i + 1);
+            return EXIT_FAILURE;
+        }
+        phases[0][i] = timings.startup.connect;
+        phases[1][i] = timings.startup.registry;
+        phases[2][i] = timings.startup.surface;
+        phases[3][i] = timings.startup.configure;
+        phases[4][i] = timings.startup.total;
+        phases[5][i] = timings.frame;
+        phases[6][i] = timings.first;
+    }
+
+    (void)printf("%zu runs, in microseconds.\n", runs);
+    (void)printf("%-10s %10s %10s %10s\n", "phase", "min", "median", "max");
+    report("connect", phases[0], runs);
+    report("registry", phases[1], runs);
+    report("surface", phases[2], runs);
+    report("configure", phases[3], runs);
+    report("total", phases[4], runs);
+    report("frame", phases[5], runs);
+    report("first", phases[6], runs);
+    return EXIT_SUCCESS;
+}
@@ -19,7 +19,794 @@
 #define HYACINTH_MAJOR_VERSION 0
 #define HYACINTH_MINOR_VERSION 0
 #define HYACINTH_PATCH_VERSION 0
-#define HYACINTH_TWEAK_VERSION 44
+#define HYACINTH_TWEAK_VERSION 69
+
+/**
+ * @def HYACINTH_PRESENTED_VSYNC
+ * @brief The presentation was synchronized to the vertical retrace of the
+ * display, so it did not tear.
+ * @since v0.0.0.48
+ */
+#define HYACINTH_PRESENTED_VSYNC 0x1
+
+/**
+ * @def HYACINTH_PRESENTED_HW_CLOCK
+ * @brief The presentation timestamp was taken from the display hardware, not
+ * estimated by the compositor.
+ * @since v0.0.0.48
+ */
+#define HYACINTH_PRESENTED_HW_CLOCK 0x2
+
+/**
+ * @def HYACINTH_PRESENTED_HW_COMPLETION
+ * @brief The display hardware signalled that it started using the new image
+ * content, instead of the compositor assuming so.
+ * @since v0.0.0.48
+ */
+#define HYACINTH_PRESENTED_HW_COMPLETION 0x4
+
+/**
+ * @def HYACINTH_PRESENTED_ZERO_COPY
+ * @brief The buffer was scanned out directly, without the compositor copying or
+ * blending it.
+ * @since v0.0.0.48
+ */
+#define HYACINTH_PRESENTED_ZERO_COPY 0x8
+
+/**
+ * @struct hyacinth_presentation Hyacinth.h "Hyacinth.h"
+ * @brief The measured fate of a single presented frame, as reported by the
+ * windowing system. All times are in nanoseconds on the clock read by @ref
+ * hyacinth_getTime.
+ * @since v0.0.0.48
+ */
+typedef struct hyacinth_presentation
+{
+    /**
+     * @property submitted
+     * @brief The time at which presentation feedback was requested for the
+     * frame, which should be just before it was handed to the compositor.
+     * @since v0.0.0.48
+     */
+    uint64_t submitted;
+    /**
+     * @property presented
+     * @brief The time at which the frame turned into light, or zero if the
+     * frame was discarded. Subtracting @ref submitted gives the latency.
+     * @since v0.0.0.48
+     */
+    uint64_t presented;
+    /**
+     * @property sequence
+     * @brief The vertical retrace counter of the output at presentation, or
+     * zero if the output has no such counter.
+     * @since v0.0.0.48
+     */
+    uint64_t sequence;
+    /**
+     * @property refresh
+     * @brief The refresh interval of the output at presentation, or zero if it
+     * is unknown or variable.
+     * @since v0.0.0.48
+     */
+    uint32_t refresh;
+    /**
+     * @property flags
+     * @brief A bitmask of the @c HYACINTH_PRESENTED_* flags describing how the
+     * frame was presented. This is always zero for discarded frames.
+     * @since v0.0.0.48
+     */
+    uint32_t flags;
+    /**
+     * @property discarded
+     * @brief Whether the frame was never shown at all, usually because a newer
+     * frame replaced it before the next refresh.
+     * @since v0.0.0.48
+     */
+    bool discarded;
+} hyacinth_presentation;
+
+/**
+ * @def HYACINTH_FORMAT_ARGB8888
+ * @brief 32-bit pixels laid out as @c 0xAARRGGBB in native endianness, with
+ * premultiplied alpha.
+ * @since v0.0.0.50
+ */
+#define HYACINTH_FORMAT_ARGB8888 0
+
+/**
+ * @def HYACINTH_FORMAT_XRGB8888
+ * @brief 32-bit pixels laid out as @c 0xXXRRGGBB in native endianness. The top
+ * byte is ignored.
+ * @since v0.0.0.50
+ */
+#define HYACINTH_FORMAT_XRGB8888 1
+
+/**
+ * @struct hyacinth_rect Hyacinth.h "Hyacinth.h"
+ * @brief An axis-aligned rectangle, in pixels.
+ * @since v0.0.0.52
+ */
+typedef struct hyacinth_rect
+{
+    /**
+     * @property x
+     * @brief The left edge of the rectangle.
+     * @since v0.0.0.52
+     */
+    int32_t x;
+    /**
+     * @property y
+     * @brief The top edge of the rectangle.
+     * @since v0.0.0.52
+     */
+    int32_t y;
+    /**
+     * @property width
+     * @brief The width of the rectangle.
+     * @since v0.0.0.52
+     */
+    int32_t width;
+    /**
+     * @property height
+     * @brief The height of the rectangle.
+     * @since v0.0.0.52
+     */
+    int32_t height;
+} hyacinth_rect;
+
+/**
+ * @struct hyacinth_buffer Hyacinth.h "Hyacinth.h"
+ * @brief A CPU-writable framebuffer, as handed out by @ref
+ * hyacinth_acquireBuffer. The memory is owned by Hyacinth and stays valid
+ * until the buffer is handed back via @ref hyacinth_present.
+ * @since v0.0.0.50
+ */
+typedef struct hyacinth_buffer
+{
+    /**
+     * @property pixels
+     * @brief The first pixel of the top row of the buffer.
+     * @since v0.0.0.50
+     */
+    void *pixels;
+    /**
+     * @property width
+     * @brief The width of the buffer in pixels.
+     * @since v0.0.0.50
+     */
+    uint32_t width;
+    /**
+     * @property height
+     * @brief The height of the buffer in pixels.
+     * @since v0.0.0.50
+     */
+    uint32_t height;
+    /**
+     * @property stride
+     * @brief The distance between the starts of two rows, in bytes.
+     * @since v0.0.0.50
+     */
+    uint32_t stride;
+    /**
+     * @property format
+     * @brief The layout of each pixel, one of the @c HYACINTH_FORMAT_* values.
+     * @since v0.0.0.50
+     */
+    uint32_t format;
+    /**
+     * @property age
+     * @brief How many frames ago the current contents of the buffer were
+     * presented; one means they are the previous frame. Only what changed
+     * since then needs to be drawn. Zero means the contents are undefined,
+     * and everything must be drawn.
+     * @since v0.0.0.52
+     */
+    uint32_t age;
+} hyacinth_buffer;
+
+/**
+ * @struct hyacinth_swapchain_stats Hyacinth.h "Hyacinth.h"
+ * @brief Counters describing how well the software swapchain keeps up with the
+ * application. These only ever grow.
+ * @since v0.0.0.51
+ */
+typedef struct hyacinth_swapchain_stats
+{
+    /**
+     * @property acquired
+     * @brief The number of buffers ever handed out by @ref
+     * hyacinth_acquireBuffer.
+     * @since v0.0.0.51
+     */
+    uint64_t acquired;
+    /**
+     * @property starved
+     * @brief The number of acquisitions that found every buffer still held by
+     * the compositor, and so had to wait. If this grows steadily, the
+     * swapchain is too shallow.
+     * @since v0.0.0.51
+     */
+    uint64_t starved;
+    /**
+     * @property waited
+     * @brief The total time spent waiting in starved acquisitions, in
+     * nanoseconds.
+     * @since v0.0.0.51
+     */
+    uint64_t waited;
+} hyacinth_swapchain_stats;
+
+/**
+ * @struct hyacinth_startup Hyacinth.h "Hyacinth.h"
+ * @brief How long each phase of creating the window took, in nanoseconds.
+ * @since v0.0.0.68
+ */
+typedef struct hyacinth_startup
+{
+    /**
+     * @property connect
+     * @brief The time taken to connect to the windowing system.
+     * @since v0.0.0.68
+     */
+    uint64_t connect;
+    /**
+     * @property registry
+     * @brief The time taken to learn of and bind every global object, which
+     * is the one full roundtrip of creation.
+     * @since v0.0.0.68
+     */
+    uint64_t registry;
+    /**
+     * @property surface
+     * @brief The time taken to build the window itself. This never waits on
+     * the windowing system.
+     * @since v0.0.0.68
+     */
+    uint64_t surface;
+    /**
+     * @property configure
+     * @brief The time spent waiting for the window to be configured, after
+     * which its size is known and drawing may begin.
+     * @since v0.0.0.68
+     */
+    uint64_t configure;
+    /**
+     * @property total
+     * @brief The time taken by the whole of @ref hyacinth_create.
+     * @since v0.0.0.68
+     */
+    uint64_t total;
+} hyacinth_startup;
+
+/**
+ * @def HYACINTH_OUTPUT_MAX
+ * @brief The most outputs Hyacinth keeps track of at once. Any more than that
+ * are ignored until others are unplugged.
+ * @since v0.0.0.60
+ */
+#define HYACINTH_OUTPUT_MAX 8
+
+/**
+ * @struct hyacinth_output Hyacinth.h "Hyacinth.h"
+ * @brief Everything known about a single output, usually a monitor.
+ * @since v0.0.0.60
+ */
+typedef struct hyacinth_output
+{
+    /**
+     * @property id
+     * @brief The identifier of the output, never zero. This stays the same
+     * for as long as the output is plugged in, but a replugged output gets a
+     * new one.
+     * @since v0.0.0.60
+     */
+    uint32_t id;
+    /**
+     * @property x
+     * @brief The horizontal position of the output within the compositor's
+     * space, which may not mean much.
+     * @since v0.0.0.60
+     */
+    int32_t x;
+    /**
+     * @property y
+     * @brief The vertical position of the output within the compositor's
+     * space, which may not mean much.
+     * @since v0.0.0.60
+     */
+    int32_t y;
+    /**
+     * @property physicalWidth
+     * @brief The physical width of the output in millimeters, or zero if it
+     * has none, like a projector.
+     * @since v0.0.0.60
+     */
+    int32_t physicalWidth;
+    /**
+     * @property physicalHeight
+     * @brief The physical height of the output in millimeters, or zero.
+     * @since v0.0.0.60
+     */
+    int32_t physicalHeight;
+    /**
+     * @property width
+     * @brief The width of the current mode of the output in pixels, or zero
+     * if unknown.
+     * @since v0.0.0.61
+     */
+    int32_t width;
+    /**
+     * @property height
+     * @brief The height of the current mode of the output in pixels, or zero
+     * if unknown.
+     * @since v0.0.0.61
+     */
+    int32_t height;
+    /**
+     * @property refresh
+     * @brief The refresh rate of the current mode of the output in millihertz,
+     * or zero if unknown or variable.
+     * @since v0.0.0.61
+     */
+    int32_t refresh;
+    /**
+     * @property scale
+     * @brief The integer scale of screen coordinates to pixels.
+     * @since v0.0.0.60
+     */
+    int32_t scale;
+    /**
+     * @property transform
+     * @brief The rotation and flipping of the output, as a @c
+     * wl_output_transform.
+     * @since v0.0.0.60
+     */
+    uint32_t transform;
+    /**
+     * @property name
+     * @brief The name of the output, like @c DP-1, or empty if unknown.
+     * @since v0.0.0.60
+     */
+    char name[32];
+    /**
+     * @property description
+     * @brief A human-readable description of the output, usually its make and
+     * model, or empty if unknown.
+     * @since v0.0.0.60
+     */
+    char description[96];
+} hyacinth_output;
+
+/**
+ * @enum hyacinth_event_type
+ * @brief The kinds of event Hyacinth can deliver through @ref
+ * hyacinth_nextEvent.
+ * @since v0.0.0.49
+ */
+typedef enum hyacinth_event_type
+{
+    /**
+     * @property HYACINTH_EVENT_CLOSE
+     * @brief The window has been asked to close, or the connection to the
+     * windowing system has died. This carries no data.
+     * @since v0.0.0.49
+     */
+    HYACINTH_EVENT_CLOSE,
+    /**
+     * @property HYACINTH_EVENT_RESIZE
+     * @brief The size of the window's framebuffer has changed. This carries
+     * the @c resize member.
+     * @since v0.0.0.49
+     */
+    HYACINTH_EVENT_RESIZE,
+    /**
+     * @property HYACINTH_EVENT_FRAME
+     * @brief The frame asked for by @ref hyacinth_requestFrame is ready to be
+     * drawn. This carries the @c frame member.
+     * @since v0.0.0.49
+     */
+    HYACINTH_EVENT_FRAME,
+    /**
+     * @property HYACINTH_EVENT_POINTER_ENTER
+     * @brief The pointer has entered the window. This carries the @c pointer
+     * member.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_POINTER_ENTER,
+    /**
+     * @property HYACINTH_EVENT_POINTER_LEAVE
+     * @brief The pointer has left the window. This carries no data.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_POINTER_LEAVE,
+    /**
+     * @property HYACINTH_EVENT_POINTER
+     * @brief The pointer was moved, clicked, and/or scrolled, all as a single
+     * logical action. Which of these happened is told by @ref
+     * HYACINTH_FLAG_MOTION, @ref HYACINTH_FLAG_BUTTON, and @ref
+     * HYACINTH_FLAG_AXIS. This carries the @c pointer member.
+     * @since v0.0.0.55
+     */
+    HYACINTH_EVENT_POINTER,
+    /**
+     * @property HYACINTH_EVENT_POINTER_RELATIVE
+     * @brief The pointer device moved, whether or not the pointer itself did.
+     * This is sent at the rate of the device, even while the pointer is locked
+     * in place or stopped at the edge of the screen, and carries the @c
+     * relative member. Its timestamp has microsecond precision.
+     * @since v0.0.0.56
+     *
+     * @remark As of v0.0.0.69, this is only sent after @ref
+     * hyacinth_setRelativeMotion, or while the pointer is locked.
+     */
+    HYACINTH_EVENT_POINTER_RELATIVE,
+    /**
+     * @property HYACINTH_EVENT_POINTER_CONSTRAINT
+     * @brief The pointer lock or confinement requested via @ref
+     * hyacinth_lockPointer or @ref hyacinth_confinePointer was engaged or
+     * disengaged, as told by @ref HYACINTH_FLAG_ACTIVE. The compositor
+     * disengages it when the window loses focus, and engages it again when it
+     * is regained.
+     * @since v0.0.0.56
+     */
+    HYACINTH_EVENT_POINTER_CONSTRAINT,
+    /**
+     * @property HYACINTH_EVENT_KEYBOARD_ENTER
+     * @brief The window has gained keyboard focus. This carries no data.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_KEYBOARD_ENTER,
+    /**
+     * @property HYACINTH_EVENT_KEYBOARD_LEAVE
+     * @brief The window has lost keyboard focus. Any keys still held should be
+     * considered released. This carries no data.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_KEYBOARD_LEAVE,
+    /**
+     * @property HYACINTH_EVENT_KEY
+     * @brief A key was pressed or released, as told by @ref
+     * HYACINTH_FLAG_PRESSED. This carries the @c key member.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_KEY,
+    /**
+     * @property HYACINTH_EVENT_MODIFIERS
+     * @brief The state of the keyboard modifiers has changed. This carries the
+     * @c modifiers member.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_MODIFIERS,
+    /**
+     * @property HYACINTH_EVENT_TOUCH_DOWN
+     * @brief A new touch point has appeared. This carries the @c touch member.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_TOUCH_DOWN,
+    /**
+     * @property HYACINTH_EVENT_TOUCH_UP
+     * @brief A touch point has disappeared. This carries the @c touch member,
+     * of which only the identifier is meaningful.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_TOUCH_UP,
+    /**
+     * @property HYACINTH_EVENT_TOUCH_MOTION
+     * @brief A touch point has moved. This carries the @c touch member.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_TOUCH_MOTION,
+    /**
+     * @property HYACINTH_EVENT_TOUCH_CANCEL
+     * @brief The compositor has taken over the current touch sequence; every
+     * active touch point should be forgotten. This carries no data.
+     * @since v0.0.0.54
+     */
+    HYACINTH_EVENT_TOUCH_CANCEL,
+    /**
+     * @property HYACINTH_EVENT_OUTPUT_CHANGED
+     * @brief An output was plugged in, or something about it changed. This
+     * carries the @c output member.
+     * @since v0.0.0.60
+     */
+    HYACINTH_EVENT_OUTPUT_CHANGED,
+    /**
+     * @property HYACINTH_EVENT_OUTPUT_REMOVED
+     * @brief An output was unplugged. This carries the @c output member.
+     * @since v0.0.0.60
+     */
+    HYACINTH_EVENT_OUTPUT_REMOVED,
+    /**
+     * @property HYACINTH_EVENT_STATE
+     * @brief The state of the window has changed; see @ref
+     * hyacinth_getState. This carries the @c state member.
+     * @since v0.0.0.65
+     */
+    HYACINTH_EVENT_STATE,
+    /**
+     * @property HYACINTH_EVENT_CONNECTED
+     * @brief The window being created by @ref hyacinth_createAsync has been
+     * built, and awaits its first configuration. This carries no data.
+     * @since v0.0.0.69
+     */
+    HYACINTH_EVENT_CONNECTED,
+    /**
+     * @property HYACINTH_EVENT_CONFIGURED
+     * @brief The window has been configured for the first time, so its size
+     * is known and drawing may begin. This carries the @c resize member.
+     * @since v0.0.0.69
+     */
+    HYACINTH_EVENT_CONFIGURED,
+} hyacinth_event_type;
+
+/**
+ * @def HYACINTH_FLAG_PRESSED
+ * @brief Set in the flags of a button or key event if the button or key was
+ * pressed, and clear if it was released.
+ * @since v0.0.0.54
+ */
+#define HYACINTH_FLAG_PRESSED 0x1
+
+/**
+ * @def HYACINTH_FLAG_MOTION
+ * @brief Set in the flags of a pointer event if the pointer moved.
+ * @since v0.0.0.55
+ */
+#define HYACINTH_FLAG_MOTION 0x2
+
+/**
+ * @def HYACINTH_FLAG_BUTTON
+ * @brief Set in the flags of a pointer event if a button was pressed or
+ * released, as told by @ref HYACINTH_FLAG_PRESSED.
+ * @since v0.0.0.55
+ */
+#define HYACINTH_FLAG_BUTTON 0x4
+
+/**
+ * @def HYACINTH_FLAG_AXIS
+ * @brief Set in the flags of a pointer event if the pointer was scrolled.
+ * @since v0.0.0.55
+ */
+#define HYACINTH_FLAG_AXIS 0x8
+
+/**
+ * @def HYACINTH_FLAG_COALESCED
+ * @brief Set in the flags of a pointer event if it stands for several motion
+ * events merged together; see @ref hyacinth_coalesceMotion.
+ * @since v0.0.0.55
+ *
+ * @remark As of v0.0.0.69, this is also set in the flags of merged relative
+ * motion events.
+ */
+#define HYACINTH_FLAG_COALESCED 0x10
+
+/**
+ * @def HYACINTH_FLAG_ACTIVE
+ * @brief Set in the flags of a pointer constraint event if the constraint was
+ * engaged.
+ * @since v0.0.0.56
+ */
+#define HYACINTH_FLAG_ACTIVE 0x20
+
+/**
+ * @def HYACINTH_FLAG_REPEAT
+ * @brief Set in the flags of a key event if it was generated by the key being
+ * held down, rather than pressed anew.
+ * @since v0.0.0.59
+ */
+#define HYACINTH_FLAG_REPEAT 0x40
+
+/**
+ * @def HYACINTH_STATE_MAXIMIZED
+ * @brief The window is maximized.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_MAXIMIZED 0x1
+
+/**
+ * @def HYACINTH_STATE_FULLSCREEN
+ * @brief The window covers an entire output.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_FULLSCREEN 0x2
+
+/**
+ * @def HYACINTH_STATE_RESIZING
+ * @brief The window is being interactively resized by the user.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_RESIZING 0x4
+
+/**
+ * @def HYACINTH_STATE_ACTIVATED
+ * @brief The window has focus, and should be drawn as such.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_ACTIVATED 0x8
+
+/**
+ * @def HYACINTH_STATE_TILED_LEFT
+ * @brief The left edge of the window is tiled against something else.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_TILED_LEFT 0x10
+
+/**
+ * @def HYACINTH_STATE_TILED_RIGHT
+ * @brief The right edge of the window is tiled against something else.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_TILED_RIGHT 0x20
+
+/**
+ * @def HYACINTH_STATE_TILED_TOP
+ * @brief The top edge of the window is tiled against something else.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_TILED_TOP 0x40
+
+/**
+ * @def HYACINTH_STATE_TILED_BOTTOM
+ * @brief The bottom edge of the window is tiled against something else.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_TILED_BOTTOM 0x80
+
+/**
+ * @def HYACINTH_STATE_SUSPENDED
+ * @brief Nothing of the window can be seen, whether because it is hidden,
+ * minimized, or on a screen that is off. Frames are not being paced.
+ * @since v0.0.0.65
+ */
+#define HYACINTH_STATE_SUSPENDED 0x100
+
+/**
+ * @struct hyacinth_event Hyacinth.h "Hyacinth.h"
+ * @brief A single window event. This is a plain, fixed-size value of at most
+ * 32 bytes; it owns nothing and may be freely copied around.
+ * @since v0.0.0.49
+ *
+ * @remark All positions are in screen coordinates of the window, as 24.8
+ * fixed-point numbers; divide by 256 to get the (fractional) coordinate.
+ */
+typedef struct hyacinth_event
+{
+    /**
+     * @property time
+     * @brief The time the event happened, in nanoseconds on the clock read by
+     * @ref hyacinth_getTime.
+     * @since v0.0.0.49
+     *
+     * @remark Input events are timestamped by the compositor. These have
+     * nanosecond precision where the compositor supports precise input
+     * timestamps, and millisecond precision otherwise.
+     */
+    uint64_t time;
+    /**
+     * @property type
+     * @brief The kind of event this is, one of @ref hyacinth_event_type. This
+     * decides which member of the union is valid.
+     * @since v0.0.0.49
+     */
+    uint16_t type;
+    /**
+     * @property flags
+     * @brief Flags specific to the type of the event. These are zero unless
+     * the type documents otherwise.
+     * @since v0.0.0.49
+     */
+    uint16_t flags;
+    union
+    {
+        /**
+         * @property resize
+         * @brief The new size of the framebuffer, in pixels.
+         * @since v0.0.0.49
+         */
+        struct
+        {
+            uint32_t width;
+            uint32_t height;
+        } resize;
+        /**
+         * @property frame
+         * @brief The compositor's timestamp of the frame, in milliseconds of an
+         * undefined base.
+         * @since v0.0.0.49
+         */
+        struct
+        {
+            uint32_t time;
+        } frame;
+        /**
+         * @property pointer
+         * @brief The position of the pointer, the distance scrolled along
+         * each axis in the same units, and the Linux input event code of the
+         * button (like @c BTN_LEFT) pressed or released, if any.
+         * @since v0.0.0.55
+         */
+        struct
+        {
+            int32_t x;
+            int32_t y;
+            int32_t scrollX;
+            int32_t scrollY;
+            uint32_t button;
+        } pointer;
+        /**
+         * @property relative
+         * @brief The distance the pointer moved, with pointer acceleration
+         * applied, and the distance the device itself moved, without it. The
+         * latter is in the units of the device, which are usually, but not
+         * necessarily, the same as those of the former.
+         * @since v0.0.0.56
+         */
+        struct
+        {
+            int32_t dx;
+            int32_t dy;
+            int32_t rawX;
+            int32_t rawY;
+        } relative;
+        /**
+         * @property key
+         * @brief The Linux input event code of the key, like @c KEY_A, and
+         * the XKB keysym it produces under the current layout and modifiers,
+         * like @c XKB_KEY_a, or zero if it produces none.
+         * @since v0.0.0.58
+         */
+        struct
+        {
+            uint32_t key;
+            uint32_t keysym;
+        } key;
+        /**
+         * @property modifiers
+         * @brief The XKB modifier masks and the active layout group.
+         * @since v0.0.0.54
+         */
+        struct
+        {
+            uint32_t depressed;
+            uint32_t latched;
+            uint32_t locked;
+            uint32_t group;
+        } modifiers;
+        /**
+         * @property touch
+         * @brief The identifier of the touch point, unique while it lasts, and
+         * its position.
+         * @since v0.0.0.54
+         */
+        struct
+        {
+            int32_t id;
+            int32_t x;
+            int32_t y;
+        } touch;
+        /**
+         * @property output
+         * @brief The identifier of the output; see @ref hyacinth_output.
+         * @since v0.0.0.60
+         */
+        struct
+        {
+            uint32_t id;
+        } output;
+        /**
+         * @property state
+         * @brief The new state of the window, and which of its bits changed,
+         * as a set of @c HYACINTH_STATE_* bits.
+         * @since v0.0.0.65
+         */
+        struct
+        {
+            uint32_t states;
+            uint32_t changed;
+        } state;
+    };
+} hyacinth_event;
 
 /**
  * @fn bool hyacinth_create(void)
@@ -30,7 +817,18 @@
  * @since v0.0.0.1
  *
  * @remark The created window is always fullscreen, undecorated, and focused off
- * the bat.
+ * the bat. It is also declared entirely opaque; see @ref hyacinth_setOpaque.
+ *
+ * @remark As of v0.0.0.68, this returns only once the window has been
+ * configured, so its size is known and the first frame can be drawn right
+ * away. Everything after learning of the global objects is sent at once, so
+ * this costs just one roundtrip and the wait for the configuration; see @ref
+ * hyacinth_getStartup.
+ *
+ * @remark As of v0.0.0.69, the configuration is acknowledged before this
+ * returns. Later ones are acknowledged on the calling thread whenever events
+ * are processed or read through @ref hyacinth_nextEvent, or, with software
+ * buffers, by @ref hyacinth_present.
  *
  * @param[in] title The title you wish your window to have. This must be
  * NUL-terminated, it is not edited in any way during the course of the
@@ -42,6 +840,34 @@
 [[nodiscard]] [[gnu::nonnull(1)]]
 bool hyacinth_create(const char *title);
 
+/**
+ * @fn bool hyacinth_createAsync(const char *title)
+ * @brief Begin creating the main window object of the engine, without waiting
+ * on the windowing system at all. The rest of creation happens as events are
+ * processed, and is announced by @ref HYACINTH_EVENT_CONNECTED and then @ref
+ * HYACINTH_EVENT_CONFIGURED; the application is free to do other work, like
+ * loading assets, in the meantime. The same rules as @ref hyacinth_create
+ * apply.
+ * @since v0.0.0.69
+ *
+ * @remark Until the window is configured, only event processing and @ref
+ * hyacinth_destroy may be used. The reader thread is best started once @ref
+ * HYACINTH_EVENT_CONNECTED has arrived, since the key repeat timer it waits
+ * upon is only made then. Should creation fail along the way, a message is
+ * logged and the window closes.
+ *
+ * @remark The configuration is acknowledged by the time @ref
+ * HYACINTH_EVENT_CONFIGURED is handed out, so the first frame may be committed
+ * as soon as it is seen.
+ *
+ * @param[in] title The title you wish your window to have. This must be
+ * NUL-terminated; it is copied.
+ * @return A boolean value representing whether or not the connection to the
+ * windowing system was made.
+ */
+[[nodiscard]] [[gnu::nonnull(1)]]
+bool hyacinth_createAsync(const char *title);
+
 /**
  * @fn void hyacinth_destroy(void)
  * @brief Destroy the main window object of the engine. This should only be
@@ -58,6 +884,23 @@ bool hyacinth_create(const char *title);
  */
 void hyacinth_destroy(void);
 
+/**
+ * @fn void hyacinth_getStartup(hyacinth_startup *startup)
+ * @brief Get how long the last call to @ref hyacinth_create took, phase by
+ * phase.
+ * @since v0.0.0.68
+ *
+ * @remark For @ref hyacinth_createAsync, the phases are complete once @ref
+ * HYACINTH_EVENT_CONFIGURED has arrived. The registry and configuration phases
+ * each end only when the application next processes events, so both include
+ * any time it spent elsewhere before then, as does the total. Only the
+ * connection and surface phases are Hyacinth's alone.
+ *
+ * @param[out] startup The storage for the timings.
+ */
+[[gnu::nonnull(1)]]
+void hyacinth_getStartup(hyacinth_startup *startup);
+
 /**
  * @fn bool hyacinth_process(void)
  * @brief Process any and all window events and clear the queue. This should be
@@ -65,6 +908,10 @@ void hyacinth_destroy(void);
  * process things like user input, close events, etc.
  * @since v0.0.0.2
  *
+ * @remark While the window is suspended and @ref hyacinth_setThrottle is on,
+ * this does not return until the window can be seen again or is closed. @ref
+ * hyacinth_poll and @ref hyacinth_processTimeout still keep to their timeouts.
+ *
  * @return A boolean value representing whether or not event processing
  * succeeded. If false is returned, the window should close, no questions asked.
  * The window processing failing does not necessarily mean an error has
@@ -73,6 +920,158 @@ void hyacinth_destroy(void);
 [[nodiscard]] [[gnu::hot]]
 bool hyacinth_process(void);
 
+/**
+ * @fn bool hyacinth_poll(void)
+ * @brief Process any window events that are already waiting, without ever
+ * sleeping. This is @ref hyacinth_process for render loops that cannot afford
+ * to stall when the compositor has nothing to say.
+ * @since v0.0.0.45
+ *
+ * @return A boolean value representing whether or not event processing
+ * succeeded. This is to be treated exactly like the return value of @ref
+ * hyacinth_process; finding no events is not a failure.
+ */
+[[nodiscard]] [[gnu::hot]]
+bool hyacinth_poll(void);
+
+/**
+ * @fn bool hyacinth_processTimeout(uint64_t ns)
+ * @brief Process window events, waiting at most the given amount of time for
+ * some to arrive. This returns as soon as any events have been processed, so
+ * it can be used to bound the wait to whatever remains of a frame budget.
+ * @since v0.0.0.45
+ *
+ * @param[in] ns The maximum time to wait for events, in nanoseconds. Zero
+ * behaves exactly like @ref hyacinth_poll.
+ * @return A boolean value representing whether or not event processing
+ * succeeded. This is to be treated exactly like the return value of @ref
+ * hyacinth_process; timing out is not a failure.
+ */
+[[nodiscard]] [[gnu::hot]]
+bool hyacinth_processTimeout(uint64_t ns);
+
+/**
+ * @fn int hyacinth_getFD(void)
+ * @brief Get the file descriptor of the connection to the windowing system, so
+ * that it may be waited upon by an external event loop like @c epoll. This is
+ * to be used alongside @ref hyacinth_prepareRead, @ref hyacinth_readEvents,
+ * @ref hyacinth_dispatch, and @ref hyacinth_flush, in place of @ref
+ * hyacinth_process.
+ * @since v0.0.0.46
+ *
+ * @remark A single iteration of an external loop should look like so; prepare
+ * to read, flush, wait for the descriptor to become readable, then either read
+ * events or cancel the read, and finally dispatch. Skipping the prepare step
+ * or forgetting to read/cancel will deadlock the connection.
+ *
+ * @return The descriptor. This is owned by Hyacinth and must never be closed,
+ * read from, or written to directly.
+ */
+[[nodiscard]] [[gnu::pure]]
+int hyacinth_getFD(void);
+
+/**
+ * @fn bool hyacinth_prepareRead(void)
+ * @brief Announce the intention to read from the descriptor returned by @ref
+ * hyacinth_getFD. Any events already queued are dispatched first, since the
+ * read cannot be prepared while they linger.
+ * @since v0.0.0.46
+ *
+ * @remark Every successful call must be matched by exactly one call to either
+ * @ref hyacinth_readEvents or @ref hyacinth_cancelRead.
+ *
+ * @return A boolean value representing whether or not the read was prepared.
+ * If false is returned, nothing needs to be cancelled and the window should
+ * close, just as with @ref hyacinth_process.
+ */
+[[nodiscard]]
+bool hyacinth_prepareRead(void);
+
+/**
+ * @fn bool hyacinth_readEvents(void)
+ * @brief Read any events waiting on the descriptor into the queue, without
+ * dispatching them. This should be called once the descriptor has been
+ * reported readable, after @ref hyacinth_prepareRead.
+ * @since v0.0.0.46
+ *
+ * @return A boolean value representing whether or not reading succeeded. If
+ * false is returned, the window should close.
+ */
+[[nodiscard]]
+bool hyacinth_readEvents(void);
+
+/**
+ * @fn void hyacinth_cancelRead(void)
+ * @brief Give up on a read prepared by @ref hyacinth_prepareRead, for example
+ * because the wait was woken by some other source.
+ * @since v0.0.0.46
+ */
+void hyacinth_cancelRead(void);
+
+/**
+ * @fn int hyacinth_getRepeatFD(void)
+ * @brief Get the file descriptor of the key repeat timer, which external event
+ * loops must wait upon alongside @ref hyacinth_getFD in order to deliver key
+ * repeats on time. Whenever it is readable, call @ref hyacinth_dispatch.
+ * @since v0.0.0.59
+ *
+ * @remark While the reader thread is running, it waits on the timer itself,
+ * and this returns -1.
+ *
+ * @return The descriptor, or -1 if there is none. This is owned by Hyacinth
+ * and must never be closed, read from, or written to directly.
+ */
+[[nodiscard]] [[gnu::pure]]
+int hyacinth_getRepeatFD(void);
+
+/**
+ * @fn bool hyacinth_dispatch(void)
+ * @brief Dispatch all queued events, without reading from or waiting upon the
+ * descriptor at all. This also delivers any key repeats that have come due.
+ * @since v0.0.0.46
+ *
+ * @return A boolean value representing whether or not event processing
+ * succeeded. This is to be treated exactly like the return value of @ref
+ * hyacinth_process.
+ */
+[[nodiscard]] [[gnu::hot]]
+bool hyacinth_dispatch(void);
+
+/**
+ * @fn void hyacinth_beginBatch(void)
+ * @brief Begin a batch of changes to the window, like requesting a frame,
+ * setting the viewport, and presenting. None of them are sent until @ref
+ * hyacinth_flush ends the batch, so the whole frame reaches the windowing
+ * system in a single write.
+ * @since v0.0.0.67
+ *
+ * @remark Processing events in the middle of a batch sends whatever has been
+ * batched so far.
+ *
+ * @remark While the reader thread runs (see @ref hyacinth_startReader), it
+ * holds off on flushing the connection for as long as the batch lasts, so
+ * anything it sends in reply to events goes out with the batch.
+ */
+void hyacinth_beginBatch(void);
+
+/**
+ * @fn bool hyacinth_flush(bool *pending)
+ * @brief Send all buffered requests to the windowing system, without ever
+ * blocking.
+ * @since v0.0.0.46
+ *
+ * @remark As of v0.0.0.67, this also ends any batch begun by @ref
+ * hyacinth_beginBatch.
+ *
+ * @param[out] pending Whether or not some requests could not be written
+ * because the socket is full. If this is set, wait for the descriptor to
+ * become writable and call this function again.
+ * @return A boolean value representing whether or not flushing succeeded. If
+ * false is returned, the window should close.
+ */
+[[nodiscard]] [[gnu::nonnull(1)]]
+bool hyacinth_flush(bool *pending);
+
 /**
  * @fn void hyacinth_close(void)
  * @brief Close the window. This sends a bullet directly into the windowing
@@ -84,6 +1083,435 @@ bool hyacinth_process(void);
  */
 void hyacinth_close(void);
 
+/**
+ * @fn bool hyacinth_requestFrame(void)
+ * @brief Ask the windowing system to tell us when it's a good time to draw the
+ * next frame. This is the compositor's own pacing, so rendering only when it
+ * fires never wastes work on frames that will never be shown.
+ * @since v0.0.0.47
+ *
+ * @remark The request only takes effect once the surface is next committed,
+ * so call this right before presenting (e.g. before @c eglSwapBuffers). Asking
+ * again while a request is already in flight does nothing.
+ *
+ * @remark While the window is suspended and @ref hyacinth_setThrottle is on,
+ * no request is made.
+ *
+ * @remark As of v0.0.0.69, unless @ref hyacinth_acquireBuffer is in use, this
+ * also acknowledges the latest size from the windowing system, should it not
+ * have been already.
+ *
+ * @return A boolean value representing whether or not the request was made.
+ */
+[[nodiscard]]
+bool hyacinth_requestFrame(void);
+
+/**
+ * @fn bool hyacinth_frameReady(uint32_t *timestamp)
+ * @brief Check whether the frame asked for by @ref hyacinth_requestFrame is
+ * ready to be drawn. This never processes events itself; it only reports what
+ * the last call to @ref hyacinth_process or its siblings found.
+ * @since v0.0.0.47
+ *
+ * @param[out] timestamp The compositor's timestamp of the frame, in
+ * milliseconds of an undefined base. This may be @c nullptr.
+ * @return Whether or not a frame is ready. The readiness is consumed, so the
+ * next call returns false until another frame is requested and delivered.
+ */
+[[nodiscard]] [[gnu::hot]]
+bool hyacinth_frameReady(uint32_t *timestamp);
+
+/**
+ * @fn bool hyacinth_waitFrame(uint32_t *timestamp)
+ * @brief Process window events until the frame asked for by @ref
+ * hyacinth_requestFrame is ready to be drawn. A render loop built around this
+ * wakes exactly once per compositor refresh.
+ * @since v0.0.0.47
+ *
+ * @remark If no frame has been requested, this returns immediately.
+ *
+ * @param[out] timestamp The compositor's timestamp of the frame, in
+ * milliseconds of an undefined base. This may be @c nullptr.
+ * @return A boolean value representing whether or not event processing
+ * succeeded. This is to be treated exactly like the return value of @ref
+ * hyacinth_process.
+ */
+[[nodiscard]] [[gnu::hot]]
+bool hyacinth_waitFrame(uint32_t *timestamp);
+
+/**
+ * @fn bool hyacinth_requestPresentation(void)
+ * @brief Ask the windowing system to report when, and how, the next frame
+ * actually reaches the display. The result is later collected via @ref
+ * hyacinth_nextPresentation.
+ * @since v0.0.0.48
+ *
+ * @remark Like @ref hyacinth_requestFrame, the request only takes effect once
+ * the surface is next committed, so call this right before presenting.
+ *
+ * @return A boolean value representing whether or not the request was made.
+ * This fails if the compositor does not support presentation feedback, or if
+ * too many frames are already awaiting theirs.
+ */
+[[nodiscard]]
+bool hyacinth_requestPresentation(void);
+
+/**
+ * @fn bool hyacinth_nextPresentation(hyacinth_presentation *presentation)
+ * @brief Pop the oldest unread presentation report. Reports are kept in a
+ * small ring; if the application doesn't keep up, new reports are dropped.
+ * @since v0.0.0.48
+ *
+ * @param[out] presentation The storage for the report.
+ * @return Whether or not a report was available.
+ */
+[[nodiscard]] [[gnu::nonnull(1)]]
+bool hyacinth_nextPresentation(hyacinth_presentation *presentation);
+
+/**
+ * @fn uint64_t hyacinth_predictVblank(void)
+ * @brief Predict the time of the next vertical retrace of the display, based
+ * on the most recent presentation report. Rendering can then be scheduled to
+ * finish as late as possible before it.
+ * @since v0.0.0.48
+ *
+ * @return The predicted time in nanoseconds on the clock read by @ref
+ * hyacinth_getTime, or zero if no prediction can be made yet.
+ */
+[[nodiscard]]
+uint64_t hyacinth_predictVblank(void);
+
+/**
+ * @fn uint64_t hyacinth_getTime(void)
+ * @brief Get the current time on the clock the windowing system uses for its
+ * presentation timestamps.
+ * @since v0.0.0.48
+ *
+ * @return The current time in nanoseconds.
+ */
+[[nodiscard]]
+uint64_t hyacinth_getTime(void);
+
+/**
+ * @fn bool hyacinth_nextEvent(hyacinth_event *event)
+ * @brief Pop the oldest unread event. This never touches the windowing system;
+ * events are produced by @ref hyacinth_process and its siblings, or by the
+ * reader thread if it has been started, and simply read out here.
+ * @since v0.0.0.49
+ *
+ * @remark Events are kept in a fixed ring. If the application doesn't keep
+ * up, new events are dropped (and a warning is logged) until it does.
+ *
+ * @param[out] event The storage for the event.
+ * @return Whether or not an event was available.
+ */
+[[nodiscard]] [[gnu::hot]] [[gnu::nonnull(1)]]
+bool hyacinth_nextEvent(hyacinth_event *event);
+
+/**
+ * @fn void hyacinth_coalesceMotion(bool coalesce, bool history)
+ * @brief Merge every pointer event that is pure motion, between two reads of
+ * the event queue, into a single event carrying the latest position. The cost
+ * of handling pointer input then scales with the frames rendered rather than
+ * the polling rate of the mouse.
+ * @since v0.0.0.55
+ *
+ * @remark As of v0.0.0.69, relative motion is merged too, into an event
+ * carrying the sum of every delta. Each kind of motion is merged separately,
+ * so one never cuts the other short.
+ *
+ * @param[in] coalesce Whether or not to merge motion.
+ * @param[in] history Whether or not to also keep every unmerged motion event,
+ * to be read via @ref hyacinth_nextMotion. This is ignored unless @p coalesce
+ * is set.
+ */
+void hyacinth_coalesceMotion(bool coalesce, bool history);
+
+/**
+ * @fn bool hyacinth_nextMotion(hyacinth_event *event)
+ * @brief Pop the oldest unread pointer motion event from the history kept
+ * while coalescing motion; see @ref hyacinth_coalesceMotion. The history is
+ * kept in a ring just like the event queue.
+ * @since v0.0.0.55
+ *
+ * @param[out] event The storage for the event.
+ * @return Whether or not an event was available.
+ */
+[[nodiscard]] [[gnu::nonnull(1)]]
+bool hyacinth_nextMotion(hyacinth_event *event);
+
+/**
+ * @fn bool hyacinth_lockPointer(bool lock)
+ * @brief Lock the pointer in place while the window is focused, hiding any
+ * motion but the relative kind. This is what games and 3D viewports want for
+ * mouse look.
+ * @since v0.0.0.56
+ *
+ * @remark No @ref HYACINTH_EVENT_POINTER_CONSTRAINT event is sent when the
+ * lock is removed through this function.
+ *
+ * @param[in] lock Whether to lock or unlock the pointer.
+ * @return Whether or not the request could be made. This fails if the
+ * compositor does not support pointer constraints, there is no pointer, or the
+ * pointer is already confined.
+ */
+bool hyacinth_lockPointer(bool lock);
+
+/**
+ * @fn bool hyacinth_confinePointer(bool confine)
+ * @brief Keep the pointer within the window while it is focused.
+ * @since v0.0.0.56
+ *
+ * @remark No @ref HYACINTH_EVENT_POINTER_CONSTRAINT event is sent when the
+ * confinement is removed through this function.
+ *
+ * @param[in] confine Whether to confine or free the pointer.
+ * @return Whether or not the request could be made. This fails if the
+ * compositor does not support pointer constraints, there is no pointer, or the
+ * pointer is already locked.
+ */
+bool hyacinth_confinePointer(bool confine);
+
+/**
+ * @fn bool hyacinth_setRelativeMotion(bool relative)
+ * @brief Decide whether @ref HYACINTH_EVENT_POINTER_RELATIVE events are sent
+ * while the pointer is not locked. They are off by default, since they double
+ * the events each movement of the mouse makes.
+ * @since v0.0.0.69
+ *
+ * @remark While the pointer is locked, they are sent regardless.
+ *
+ * @param[in] relative Whether or not to send relative motion.
+ * @return Whether or not relative motion can be sent right now. This fails if
+ * the compositor does not support it, or there is no pointer yet, in which
+ * case it starts once one appears.
+ */
+bool hyacinth_setRelativeMotion(bool relative);
+
+/**
+ * @fn bool hyacinth_startReader(void)
+ * @brief Hand all event processing off to a thread owned by Hyacinth. Events
+ * are read as soon as they arrive, no matter what the calling thread is up to,
+ * and are delivered through @ref hyacinth_nextEvent.
+ * @since v0.0.0.49
+ *
+ * @remark While the reader runs, @ref hyacinth_process and its siblings no
+ * longer touch the connection beyond flushing it; they instead wait for the
+ * reader to deliver something. Likewise, the descriptor from @ref
+ * hyacinth_getFD becomes one that is readable whenever events have been
+ * delivered.
+ *
+ * @return A boolean value representing whether or not the thread was started.
+ * Starting it twice is not an error.
+ */
+[[nodiscard]]
+bool hyacinth_startReader(void);
+
+/**
+ * @fn void hyacinth_stopReader(void)
+ * @brief Stop the thread started by @ref hyacinth_startReader and take event
+ * processing back onto the calling thread. This is done automatically by @ref
+ * hyacinth_destroy.
+ * @since v0.0.0.49
+ */
+void hyacinth_stopReader(void);
+
+/**
+ * @fn bool hyacinth_acquireBuffer(hyacinth_buffer *buffer)
+ * @brief Get a shared-memory framebuffer to draw into with the CPU, for when
+ * there's no GPU API at hand (or no GPU at all). The buffers are allocated
+ * once, and only reallocated when the window changes size.
+ * @since v0.0.0.50
+ *
+ * @remark This must not be mixed with any other means of presenting to the
+ * surface, like EGL or Vulkan. This never waits if any buffer of the swapchain
+ * is free; if every one is still being read by the compositor, this processes
+ * events until one is released.
+ *
+ * @param[out] buffer The storage for the description of the buffer.
+ * @return A boolean value representing whether or not a buffer was acquired.
+ * This fails if the compositor doesn't offer shared memory, if the window
+ * hasn't been given a size yet, or if allocation failed.
+ */
+[[nodiscard]] [[gnu::nonnull(1)]]
+bool hyacinth_acquireBuffer(hyacinth_buffer *buffer);
+
+/**
+ * @fn void hyacinth_damage(const hyacinth_rect *rect)
+ * @brief Mark a region of the acquired buffer as changed, so that only the
+ * changed regions are sent to the compositor on @ref hyacinth_present. Nearby
+ * rectangles are merged, and if the damage grows too scattered or too large it
+ * simply becomes the whole buffer.
+ * @since v0.0.0.52
+ *
+ * @remark If nothing is damaged before presenting, the whole buffer is assumed
+ * to have changed.
+ *
+ * @param[in] rect The changed region, in pixels of the buffer. This is clipped
+ * to the buffer.
+ */
+[[gnu::nonnull(1)]]
+void hyacinth_damage(const hyacinth_rect *rect);
+
+/**
+ * @fn bool hyacinth_present(void)
+ * @brief Present the buffer acquired by @ref hyacinth_acquireBuffer, handing it
+ * back to Hyacinth. It must not be written to after this.
+ * @since v0.0.0.50
+ *
+ * @remark Outside of a batch (see @ref hyacinth_beginBatch), the frame is sent
+ * right away. Should the connection be too backed up to take all of it, the
+ * rest follows as soon as it can, the next time events are processed.
+ *
+ * @remark As of v0.0.0.69, this is where a new size from the windowing system
+ * is acknowledged, once the buffer acquired was made at that size.
+ *
+ * @return A boolean value representing whether or not the buffer was sent off.
+ * This fails if no buffer was acquired, or if the connection died.
+ */
+[[nodiscard]]
+bool hyacinth_present(void);
+
+/**
+ * @fn bool hyacinth_setSwapchainDepth(uint32_t depth)
+ * @brief Set the number of buffers used by @ref hyacinth_acquireBuffer. The
+ * default is three, which allows drawing one frame ahead while the compositor
+ * holds both the displayed buffer and the one queued behind it.
+ * @since v0.0.0.51
+ *
+ * @remark The swapchain is reallocated on the next acquisition, so this should
+ * not be called every frame.
+ *
+ * @param[in] depth The number of buffers, from two to four.
+ * @return Whether or not the depth was valid.
+ */
+[[nodiscard]]
+bool hyacinth_setSwapchainDepth(uint32_t depth);
+
+/**
+ * @fn void hyacinth_getSwapchainStats(hyacinth_swapchain_stats *stats)
+ * @brief Get the counters of the software swapchain.
+ * @since v0.0.0.51
+ *
+ * @param[out] stats The storage for the counters.
+ */
+[[gnu::nonnull(1)]]
+void hyacinth_getSwapchainStats(hyacinth_swapchain_stats *stats);
+
+/**
+ * @fn void hyacinth_setOpaque(bool opaque)
+ * @brief Declare whether the whole window is opaque. An opaque window lets the
+ * compositor skip blending it with whatever is beneath, and possibly scan it
+ * out directly without composing at all. This is the default.
+ * @since v0.0.0.53
+ *
+ * @remark This also decides the format of the buffers handed out by @ref
+ * hyacinth_acquireBuffer; opaque windows get @ref HYACINTH_FORMAT_XRGB8888,
+ * and others @ref HYACINTH_FORMAT_ARGB8888. GPU paths should likewise pick a
+ * configuration without alpha for opaque windows. The change takes effect on
+ * the next presented frame.
+ *
+ * @param[in] opaque Whether or not the window is opaque.
+ */
+void hyacinth_setOpaque(bool opaque);
+
+/**
+ * @fn void hyacinth_setOpaqueRegion(const hyacinth_rect *rects, uint32_t count)
+ * @brief Declare only some regions of the window as opaque, for windows whose
+ * content is mostly, but not entirely, solid. The buffers of the window keep
+ * their alpha channel.
+ * @since v0.0.0.53
+ *
+ * @remark The change takes effect on the next presented frame.
+ *
+ * @param[in] rects The opaque rectangles, in screen coordinates of the window.
+ * This may be @c nullptr if @p count is zero, which declares nothing opaque.
+ * @param[in] count The number of rectangles.
+ */
+void hyacinth_setOpaqueRegion(const hyacinth_rect *rects, uint32_t count);
+
+/**
+ * @fn uint32_t hyacinth_getOutputs(hyacinth_output *outputs, uint32_t max)
+ * @brief Get a snapshot of every output currently plugged in. Watch for @ref
+ * HYACINTH_EVENT_OUTPUT_CHANGED and @ref HYACINTH_EVENT_OUTPUT_REMOVED to know
+ * when to take another.
+ * @since v0.0.0.60
+ *
+ * @param[out] outputs Storage for the outputs.
+ * @param[in] max The most outputs @p outputs can hold; @ref HYACINTH_OUTPUT_MAX
+ * is always enough.
+ * @return The number of outputs stored.
+ */
+[[gnu::nonnull(1)]]
+uint32_t hyacinth_getOutputs(hyacinth_output *outputs, uint32_t max);
+
+/**
+ * @fn bool hyacinth_getOutput(uint32_t id, hyacinth_output *output)
+ * @brief Get everything known about a single output.
+ * @since v0.0.0.61
+ *
+ * @param[in] id The identifier of the output, or zero for the output the
+ * window is shown on. If the window is on several, this is the first it
+ * entered; if it is on none yet, this is the first output plugged in.
+ * @param[out] output Storage for the output.
+ * @return Whether or not the output exists.
+ */
+[[nodiscard]] [[gnu::nonnull(2)]]
+bool hyacinth_getOutput(uint32_t id, hyacinth_output *output);
+
+/**
+ * @fn uint32_t hyacinth_getRefresh(void)
+ * @brief Get the refresh rate of the output the window is shown on, as in
+ * @ref hyacinth_getOutput, so that frame budgets can be planned around the
+ * real rate rather than an assumed 60 Hz.
+ * @since v0.0.0.61
+ *
+ * @remark Once a frame has been presented with presentation feedback, the
+ * refresh period measured by the compositor is preferred, since that is exact
+ * and follows the window between outputs.
+ *
+ * @return The refresh rate in millihertz, or zero if unknown.
+ */
+[[nodiscard]]
+uint32_t hyacinth_getRefresh(void);
+
+/**
+ * @fn bool hyacinth_setFullscreen(uint32_t output)
+ * @brief Make the window fullscreen on the given output. The window is made
+ * fullscreen on creation, on whichever output the compositor likes.
+ * @since v0.0.0.60
+ *
+ * @param[in] output The identifier of the output, or zero to let the
+ * compositor choose.
+ * @return Whether or not the output exists; if it does not, nothing happens.
+ */
+bool hyacinth_setFullscreen(uint32_t output);
+
+/**
+ * @fn uint32_t hyacinth_getState(void)
+ * @brief Get the state of the window, as last told by the windowing system.
+ * @since v0.0.0.65
+ *
+ * @return A set of @c HYACINTH_STATE_* bits.
+ */
+[[nodiscard]]
+uint32_t hyacinth_getState(void);
+
+/**
+ * @fn void hyacinth_setThrottle(bool throttle)
+ * @brief Decide whether the window stops doing work while it is suspended.
+ * When on, @ref hyacinth_process sleeps until the window can be seen again,
+ * and @ref hyacinth_requestFrame asks for nothing, so a hidden window costs
+ * next to nothing. This is off by default.
+ * @since v0.0.0.65
+ *
+ * @remark Events that arrive in the meantime are kept, and handed out once
+ * processing returns.
+ *
+ * @param[in] throttle Whether or not to throttle.
+ */
+void hyacinth_setThrottle(bool throttle);
+
 /**
  * @fn void hyacinth_getSize(uint32_t *width, uint32_t *height)
  * @brief Get the size of the window's framebuffer in pixels.
@@ -92,12 +1520,71 @@ void hyacinth_close(void);
  * @remark On most platforms, this will equal the size in screen coordinates,
  * but on some displays like the Apple Retina, this is not the case.
  *
+ * @remark As of v0.0.0.62, where the windowing system supports fractional
+ * scaling, this is exactly the number of pixels the window covers on screen,
+ * even at scales like 1.25; the compositor is told to map a buffer of this
+ * size onto the window as-is.
+ *
  * @param[out] width The storage for the width of the framebuffer in pixels.
  * @param[out] height The storage for the height of the framebuffer in pixels.
  */
 [[gnu::nonnull(1, 2)]]
 void hyacinth_getSize(uint32_t *width, uint32_t *height);
 
+/**
+ * @fn uint64_t hyacinth_getSizeGeneration(void)
+ * @brief Get a counter that goes up by one every time the size of the window
+ * in pixels changes. Renderers can compare it against the value they last
+ * built their swapchain for, rather than counting resize events.
+ * @since v0.0.0.64
+ *
+ * @remark However many times the windowing system reconfigures the window
+ * within a single batch of events, only the last configuration is applied,
+ * and this only goes up once.
+ *
+ * @return The counter.
+ */
+[[nodiscard]]
+uint64_t hyacinth_getSizeGeneration(void);
+
+/**
+ * @fn uint32_t hyacinth_getScale(void)
+ * @brief Get the scale of screen coordinates to pixels the window is drawn
+ * at, in 120ths; 120 is a scale of one, 150 of 1.25, and so on.
+ * @since v0.0.0.62
+ *
+ * @return The scale, in 120ths.
+ */
+[[nodiscard]]
+uint32_t hyacinth_getScale(void);
+
+/**
+ * @fn bool hyacinth_setViewport(uint32_t width, uint32_t height, uint32_t
+ * destWidth, uint32_t destHeight)
+ * @brief Decouple the resolution the window is rendered at from the size it
+ * is shown at; the compositor scales one to the other, usually for free in the
+ * display hardware. This is meant to be changed as often as every frame, for
+ * dynamic resolution scaling.
+ * @since v0.0.0.63
+ *
+ * @remark The change takes effect on the next presented frame. Buffers handed
+ * out by @ref hyacinth_acquireBuffer take on the new resolution; shrinking
+ * them reuses the memory already allocated. GPU paths should simply render at
+ * the new resolution.
+ *
+ * @param[in] width The width to render at in pixels, or zero for the size as
+ * per @ref hyacinth_getSize.
+ * @param[in] height The height to render at in pixels, or zero likewise.
+ * @param[in] destWidth The width to show the window at in screen coordinates,
+ * or zero for the size the window was configured to.
+ * @param[in] destHeight The height to show the window at in screen
+ * coordinates, or zero likewise.
+ * @return Whether or not the windowing system supports this. If it does not,
+ * nothing happens.
+ */
+bool hyacinth_setViewport(uint32_t width, uint32_t height, uint32_t destWidth,
+                          uint32_t destHeight);
+
 /**
  * @fn void hyacinth_getData(void **data)
  * @brief Get the native data specific to this window. Each platform has its own
@@ -2,19 +2,26 @@
  * @file Wayland.c
  * @authors Israfil Argos
  * @brief This file provides the complete Wayland implementation of the Hyacinth
- * interface. This only depends upon the default C-standard @c stdint.h, and @c
- * string.h files, and the Wayland client header @c wayland-client.h.
+ * interface. This only depends upon the C standard library, the POSIX @c
+ * dirent.h, @c errno.h, @c fcntl.h, @c poll.h, @c pthread.h, @c sys/mman.h,
+ * @c sys/stat.h, and @c unistd.h headers, the Linux @c sys/eventfd.h and @c
+ * sys/timerfd.h headers, the Wayland client header @c wayland-client.h, the
+ * xkbcommon header @c xkbcommon/xkbcommon.h, and the Hyacinth header.
  * @since v0.0.0.2
  *
- * @note This file contains material (the contents of the XDG-shell protocol)
- * copyrighted by the following people. All rights are reserved to their proper
- * owners.
+ * @note This file contains material (the contents of the XDG-shell,
+ * presentation-time, relative-pointer, pointer-constraints, input-timestamps,
+ * viewporter, and fractional-scale protocols) copyrighted by the following
+ * people. All rights are reserved to their proper owners.
  * Copyright © 2008-2013 Kristian Høgsberg
  * Copyright © 2013      Rafael Antognolli
  * Copyright © 2013      Jasper St. Pierre
  * Copyright © 2010-2013 Intel Corporation
  * Copyright © 2015-2017 Samsung Electronics Co., Ltd
  * Copyright © 2015-2017 Red Hat Inc.
+ * Copyright © 2013-2017 Collabora, Ltd.
+ * Copyright © 2014      Jonas Ådahl
+ * Copyright © 2022      Kenny Levinsen
  *
  * @copyright (c) 2025 - the Waterlily Project
  * This source file is under the GNU General Public License v3.0. For licensing
@@ -22,10 +29,29 @@
  * your copy of the source code, or https://www.gnu.org/licenses/gpl-3.0.txt.
  */
 
+#define _GNU_SOURCE
+
+#include <Hyacinth.h>
 #include <Primrose.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
 #include <wayland-client.h>
+#include <xkbcommon/xkbcommon.h>
 
 /**
  * @var bool pClose
@@ -33,8 +59,10 @@
  * the window. This does @b not instantly kill the window, it simply gives a
  * gentle nudge to begin resource deaquisition.
  * @since v0.0.0.20
+ *
+ * @remark This is atomic as of v0.0.0.49, since the reader thread may set it.
  */
-bool pClose = false;
+_Atomic bool pClose = false;
 
 /**
  * @def REFREF(expr)
@@ -143,6 +171,284 @@ static const struct wl_interface pXDGShellInterface = {
     .events = (struct wl_message[]){{"ping", "u", nullptr}},
 };
 
+/**
+ * @var const struct wl_interface pPresentationFeedbackInterface
+ * @brief The presentation feedback interface, which carries nothing but events
+ * reporting the fate of a single committed frame. This is the version one
+ * interface.
+ * @since v0.0.0.48
+ */
+static const struct wl_interface pPresentationFeedbackInterface = {
+    .name = "wp_presentation_feedback",
+    .version = 1,
+    .method_count = 0,
+    .methods = nullptr,
+    .event_count = 3,
+    .events =
+        (struct wl_message[]){
+            {"sync_output", "o", REFREF(wl_output_interface)},
+            {"presented", "uuuuuuu", nullptr},
+            {"discarded", "", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface pPresentationInterface
+ * @brief The presentation timing interface, from which we request feedback
+ * objects for individual frames. This is the version one interface.
+ * @since v0.0.0.48
+ */
+static const struct wl_interface pPresentationInterface = {
+    .name = "wp_presentation",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"feedback", "on",
+             (const struct wl_interface *[]){&wl_surface_interface,
+                                             &pPresentationFeedbackInterface}},
+        },
+    .event_count = 1,
+    .events = (struct wl_message[]){{"clock_id", "u", nullptr}},
+};
+
+/**
+ * @var const struct wl_interface pRelativePointerInterface
+ * @brief The relative pointer interface, which reports the unclamped,
+ * unaccelerated motion of a pointer. This is the version one interface.
+ * @since v0.0.0.56
+ */
+static const struct wl_interface pRelativePointerInterface = {
+    .name = "zwp_relative_pointer_v1",
+    .version = 1,
+    .method_count = 1,
+    .methods = (struct wl_message[]){{"destroy", "", nullptr}},
+    .event_count = 1,
+    .events = (struct wl_message[]){{"relative_motion", "uuffff", nullptr}},
+};
+
+/**
+ * @var const struct wl_interface pRelativePointerManagerInterface
+ * @brief The relative pointer manager interface, from which we get the
+ * relative pointer of the seat's pointer. This is the version one interface.
+ * @since v0.0.0.56
+ */
+static const struct wl_interface pRelativePointerManagerInterface = {
+    .name = "zwp_relative_pointer_manager_v1",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"get_relative_pointer", "no",
+             (const struct wl_interface *[]){&pRelativePointerInterface,
+                                             &wl_pointer_interface}},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface pLockedPointerInterface
+ * @brief The locked pointer interface, which reports whether the lock it
+ * stands for is engaged. This is the version one interface.
+ * @since v0.0.0.56
+ *
+ * @remark The position hint and region requests are missing, as we use
+ * neither.
+ */
+static const struct wl_interface pLockedPointerInterface = {
+    .name = "zwp_locked_pointer_v1",
+    .version = 1,
+    .method_count = 3,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {0},
+            {0},
+        },
+    .event_count = 2,
+    .events =
+        (struct wl_message[]){
+            {"locked", "", nullptr},
+            {"unlocked", "", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface pConfinedPointerInterface
+ * @brief The confined pointer interface, which reports whether the
+ * confinement it stands for is engaged. This is the version one interface.
+ * @since v0.0.0.56
+ *
+ * @remark The region request is missing, as we always confine to the whole
+ * surface.
+ */
+static const struct wl_interface pConfinedPointerInterface = {
+    .name = "zwp_confined_pointer_v1",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {0},
+        },
+    .event_count = 2,
+    .events =
+        (struct wl_message[]){
+            {"confined", "", nullptr},
+            {"unconfined", "", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface pPointerConstraintsInterface
+ * @brief The pointer constraints interface, from which we lock or confine the
+ * pointer to the surface. This is the version one interface.
+ * @since v0.0.0.56
+ */
+static const struct wl_interface pPointerConstraintsInterface = {
+    .name = "zwp_pointer_constraints_v1",
+    .version = 1,
+    .method_count = 3,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"lock_pointer", "noo?ou",
+             (const struct wl_interface *[]){
+                 &pLockedPointerInterface, &wl_surface_interface,
+                 &wl_pointer_interface, &wl_region_interface, nullptr}},
+            {"confine_pointer", "noo?ou",
+             (const struct wl_interface *[]){
+                 &pConfinedPointerInterface, &wl_surface_interface,
+                 &wl_pointer_interface, &wl_region_interface, nullptr}},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface pInputTimestampsInterface
+ * @brief The input timestamps interface, which sends a precise timestamp
+ * right before each input event of the device it was created for. This is the
+ * version one interface.
+ * @since v0.0.0.57
+ */
+static const struct wl_interface pInputTimestampsInterface = {
+    .name = "zwp_input_timestamps_v1",
+    .version = 1,
+    .method_count = 1,
+    .methods = (struct wl_message[]){{"destroy", "", nullptr}},
+    .event_count = 1,
+    .events = (struct wl_message[]){{"timestamp", "uuu", nullptr}},
+};
+
+/**
+ * @var const struct wl_interface pInputTimestampsManagerInterface
+ * @brief The input timestamps manager interface, from which we subscribe to
+ * the precise timestamps of each input device. This is the version one
+ * interface.
+ * @since v0.0.0.57
+ */
+static const struct wl_interface pInputTimestampsManagerInterface = {
+    .name = "zwp_input_timestamps_manager_v1",
+    .version = 1,
+    .method_count = 4,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"get_keyboard_timestamps", "no",
+             (const struct wl_interface *[]){&pInputTimestampsInterface,
+                                             &wl_keyboard_interface}},
+            {"get_pointer_timestamps", "no",
+             (const struct wl_interface *[]){&pInputTimestampsInterface,
+                                             &wl_pointer_interface}},
+            {"get_touch_timestamps", "no",
+             (const struct wl_interface *[]){&pInputTimestampsInterface,
+                                             &wl_touch_interface}},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface pViewportInterface
+ * @brief The viewport interface, which crops and scales the buffer of a
+ * surface independently of its contents. This is the version one interface.
+ * @since v0.0.0.62
+ */
+static const struct wl_interface pViewportInterface = {
+    .name = "wp_viewport",
+    .version = 1,
+    .method_count = 3,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"set_source", "ffff", nullptr},
+            {"set_destination", "ii", nullptr},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface pViewporterInterface
+ * @brief The viewporter interface, from which we get the viewport of our
+ * surface. This is the version one interface.
+ * @since v0.0.0.62
+ */
+static const struct wl_interface pViewporterInterface = {
+    .name = "wp_viewporter",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"get_viewport", "no",
+             (const struct wl_interface *[]){&pViewportInterface,
+                                             &wl_surface_interface}},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface pFractionalScaleInterface
+ * @brief The fractional scale interface, which tells the preferred scale of
+ * a surface in 120ths. This is the version one interface.
+ * @since v0.0.0.62
+ */
+static const struct wl_interface pFractionalScaleInterface = {
+    .name = "wp_fractional_scale_v1",
+    .version = 1,
+    .method_count = 1,
+    .methods = (struct wl_message[]){{"destroy", "", nullptr}},
+    .event_count = 1,
+    .events = (struct wl_message[]){{"preferred_scale", "u", nullptr}},
+};
+
+/**
+ * @var const struct wl_interface pFractionalScaleManagerInterface
+ * @brief The fractional scale manager interface, from which we get the
+ * fractional scale object of our surface. This is the version one interface.
+ * @since v0.0.0.62
+ */
+static const struct wl_interface pFractionalScaleManagerInterface = {
+    .name = "wp_fractional_scale_manager_v1",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"get_fractional_scale", "no",
+             (const struct wl_interface *[]){&pFractionalScaleInterface,
+                                             &wl_surface_interface}},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
 /**
  * @var struct wl_display *pDisplay
  * @brief The Wayland display server reference we've recieved. This is simply a
@@ -180,12 +486,54 @@ static struct wl_compositor *pCompositor = nullptr;
 static struct wl_surface *pSurface = nullptr;
 
 /**
- * @var struct wl_output *pOutput
- * @brief The pixel output device, or monitor. This is the object we pull
- * dimensions from in order to size the window.
- * @since v0.0.0.2
+ * @struct output Wayland.c "Source/Wayland.c"
+ * @brief A single pixel output device, or monitor.
+ * @since v0.0.0.60
+ */
+struct output
+{
+    /**
+     * @property proxy
+     * @brief The output object, or @c nullptr if this slot is free.
+     * @since v0.0.0.60
+     */
+    struct wl_output *proxy;
+    /**
+     * @property entered
+     * @brief Whether or not any part of the window is on this output.
+     * @since v0.0.0.60
+     */
+    bool entered;
+    /**
+     * @property order
+     * @brief When the window entered this output, as a count of entries, so
+     * the first can be told apart.
+     * @since v0.0.0.61
+     */
+    uint64_t order;
+    /**
+     * @property info
+     * @brief Everything we know about the output. The identifier is the
+     * output's name within the registry.
+     * @since v0.0.0.60
+     */
+    hyacinth_output info;
+};
+
+/**
+ * @var struct output pOutputs
+ * @brief Every output we know of. Slots are never moved around, since the
+ * listener of each output points at its own.
+ * @since v0.0.0.60
+ */
+static struct output pOutputs[HYACINTH_OUTPUT_MAX] = {0};
+
+/**
+ * @var uint64_t pOutputEntries
+ * @brief The number of times the window has entered an output.
+ * @since v0.0.0.61
  */
-static struct wl_output *pOutput = nullptr;
+static uint64_t pOutputEntries = 0;
 
 /**
  * @var struct xdg_wm_base *pShell
@@ -214,506 +562,4961 @@ static struct xdg_surface *pShellSurface = nullptr;
 static struct xdg_toplevel *pToplevel = nullptr;
 
 /**
- * @var int32_t pScale
- * @brief The monitor scale of screen coordinates to pixels. This is nearly
- * always one, unless on a display like the Apple Retina.
- * @since v0.0.0.2
+ * @var struct wl_callback *pFrameCallback
+ * @brief The frame callback currently in flight, if any. This is handed back to
+ * us by the compositor once it's a good time to draw another frame.
+ * @since v0.0.0.47
  */
-static int32_t pScale = 0;
+static struct wl_callback *pFrameCallback = nullptr;
 
 /**
- * @var uint32_t pWidth
- * @brief The width of the window in @b pixels. This value is recieved from the
- * display server and multiplied by @ref pScale to grab the actual pixel
- * value.
- * @since v0.0.0.2
+ * @var bool pFrameReady
+ * @brief Whether or not a frame callback has fired since the application last
+ * checked.
+ * @since v0.0.0.47
  */
-static uint32_t pWidth = 0;
+static _Atomic bool pFrameReady = false;
 
 /**
- * @var uint32_t pHeight
- * @brief The height of the window in @b pixels. This value is recieved from the
- * display server and multiplied by @ref pScale to grab the actual pixel
- * value.
- * @since v0.0.0.2
+ * @var uint32_t pFrameTime
+ * @brief The timestamp of the last frame callback, in milliseconds of some
+ * undefined base.
+ * @since v0.0.0.47
  */
-static uint32_t pHeight = 0;
+static _Atomic uint32_t pFrameTime = 0;
 
 /**
- * @var uint8_t pFoundInterfaces
- * @brief A count of the interfaces we've found reported by the registry. This
- * must match @ref pRequiredInterfaces, or the process will throw a
- * tantrum.
- * @since v0.0.0.35
+ * @var struct wp_presentation *pPresentation
+ * @brief The presentation timing object, if the compositor supports it. This is
+ * entirely optional; without it we simply can't measure presentation.
+ * @since v0.0.0.48
  */
-static uint8_t pFoundInterfaces = 0;
+static struct wp_presentation *pPresentation = nullptr;
 
 /**
- * @var uint8_t pRequiredInterfaces
- * @brief A count of the interfaces that the registry @b must report and connect
- * to in order for the process to complete its work successfully.
- * @since v0.0.0.35
+ * @var clockid_t pPresentationClock
+ * @brief The clock the compositor uses for presentation timestamps. This is
+ * assumed to be the monotonic clock until the compositor tells us otherwise.
+ * @since v0.0.0.48
  */
-static const uint8_t pRequiredInterfaces = 3;
+static clockid_t pPresentationClock = CLOCK_MONOTONIC;
 
 /**
- * @copydoc xdg_wm_base_listener::ping
+ * @def PENDING_PRESENTATIONS
+ * @brief The maximum number of frames that may await presentation feedback at
+ * any one time. Anything beyond a handful means the application is queueing
+ * frames far faster than they can be shown.
+ * @since v0.0.0.48
  */
-static void ping(void *, struct xdg_wm_base *b, uint32_t s)
-{
-    // xdg_wm_base_pong
-    (void)wl_proxy_marshal_flags((struct wl_proxy *)b, 3, nullptr,
-                                 wl_proxy_get_version((struct wl_proxy *)b), 0,
-                                 s);
-}
+#define PENDING_PRESENTATIONS 8
 
 /**
- * @struct xdg_wm_base_listener Wayland.c "Source/Wayland.c"
- * @brief An interface for handling events sent from the XDG "registry" object,
- * @c wm_base. This is basically a nerdy game of table tennis, we just recieve a
- * ping and send back a pong, over and over again so the WM doesn't think we're
- * a zombie.
- * @since v0.0.0.20
+ * @struct presentation_slot Wayland.c "Source/Wayland.c"
+ * @brief A single frame awaiting its presentation feedback.
+ * @since v0.0.0.48
  */
-static struct xdg_wm_base_listener
+struct presentation_slot
 {
     /**
-     * @property ping
-     * @brief The ping event asks the client if it’s still alive. Pass the
-     * serial specified in the event back to the compositor by sending a “pong”
-     * request back with the specified serial. A compositor is free to ping in
-     * any way it wants, but a client must always respond to any xdg_wm_base
-     * object it created.
-     * @since v0.0.0.20
-     *
-     * @remark It’s unspecified what will happen if the client doesn’t respond
-     * to the ping request, or in what timeframe.
-     *
-     * @param[in] data Any data to be sent alongside events.
-     * @param[in] base The window mananger base object that generated the event.
-     * @param[in] serial The serial code of the event. The client must respond
-     * to the ping with this serial code in its pong.
+     * @property feedback
+     * @brief The feedback object of the frame, or @c nullptr if the slot is
+     * free.
+     * @since v0.0.0.48
      */
-    void (*ping)(void *data, struct xdg_wm_base *base, uint32_t serial);
-}
+    struct wp_presentation_feedback *feedback;
+    /**
+     * @property submitted
+     * @brief The time at which feedback was requested, in nanoseconds.
+     * @since v0.0.0.48
+     */
+    uint64_t submitted;
+};
+
 /**
- * @var struct xdg_wm_base_listener pShellListener
- * @brief The listener for the XDG window manager base object, which is
- * basically the "registry" for the XDG Shell protocol.
- * @since v0.0.0.2
- *
- * @copydoc xdg_wm_base_listener
+ * @var struct presentation_slot pPendingPresentations
+ * @brief The frames currently awaiting presentation feedback. Each slot is
+ * handed to its feedback object as listener data, so no lookup is ever needed.
+ * @since v0.0.0.48
  */
-pShellListener = {.ping = &ping};
+static struct presentation_slot pPendingPresentations[PENDING_PRESENTATIONS] =
+    {0};
 
 /**
- * @copydoc xdg_surface_listener::configure
+ * @def PRESENTATION_RING
+ * @brief The number of presentation reports we keep around for the
+ * application to read. This must be a power of two.
+ * @since v0.0.0.48
  */
-static void configure(void *, struct xdg_surface *t, uint32_t s)
-{
-    // Acknowlege the configuration. (xdg_surface_ack_configure)
-    (void)wl_proxy_marshal_flags((struct wl_proxy *)t, 4, nullptr,
-                                 wl_proxy_get_version((struct wl_proxy *)t), 0,
-                                 s);
-    wl_surface_commit(pSurface);
-    primrose_log(VERBOSE_OK, "Configure request completed.");
-}
+#define PRESENTATION_RING 32
 
 /**
- * @struct xdg_surface_listener Wayland.c "Source/Wayland.c"
- * @brief An interface for handling events for the @c xdg_surface wrapper around
- * the @c wl_surface object.
- * @since v0.0.0.20
+ * @var hyacinth_presentation pPresentations
+ * @brief The ring of presentation reports. @ref pPresentationHead is the
+ * total number ever written, and @ref pPresentationTail the number ever read;
+ * both are reduced modulo the ring size on access. Only the producer moves the
+ * head, and only the consumer the tail, so this is safe to share with the
+ * reader thread.
+ * @since v0.0.0.48
  */
-static const struct xdg_surface_listener
-{
-    /**
-     * @property configure
-     * @brief The configure event marks the end of a configure sequence. A
-     * configure sequence is a set of one or more events configuring the state
-     * of the xdg_surface. Clients should send an ack_configure before
-     * committing the new surface.
-     * @since v0.0.0.20
-     *
-     * @remark Where applicable, xdg_surface surface roles will during a
-     * configure sequence extend this event as a latched state sent as events
-     * before the xdg_surface.configure event. If the client receives multiple
-     * configure events before it can respond to one, it is free to discard all
-     * but the last event it received.
-     *
-     * @param[in] data Any user-defined data sent alongside the surface.
-     * @param[in] surface The surface who is being configured.
-     * @param[in] serial The serial ID of this event. This should be sent
-     * alongside a configuration acknowledgement event.
-     */
-    void (*configure)(void *data, struct xdg_surface *surface, uint32_t serial);
-}
+static hyacinth_presentation pPresentations[PRESENTATION_RING] = {0};
+
 /**
- * @var struct xdg_surface_listener pShellSurfaceListener
- * @brief The listener for the XDG surface object. This handles exclusvely
- * surface-level configuration-end events sent by the server.
- * @since v0.0.0.2
- *
- * @copydoc xdg_surface_listener
+ * @var uint64_t pPresentationHead
+ * @brief The count of presentation reports ever written to @ref
+ * pPresentations.
+ * @since v0.0.0.48
  */
-pShellSurfaceListener = {&configure};
+static _Atomic uint64_t pPresentationHead = 0;
 
 /**
- * @copydoc xdg_toplevel_listener::topConfigure
+ * @var uint64_t pPresentationTail
+ * @brief The count of presentation reports ever read from @ref
+ * pPresentations.
+ * @since v0.0.0.48
  */
-static void topConfigure(void *, struct xdg_toplevel *, int32_t w, int32_t h,
-                         struct wl_array *s)
-{
-    primrose_log(VERBOSE_BEGIN, "Configure request recieved.");
+static _Atomic uint64_t pPresentationTail = 0;
 
-    pWidth = (uint32_t)(w * pScale);
-    pHeight = (uint32_t)(h * pScale);
-    primrose_log(VERBOSE, "Window dimensions adjusted: %dx%d.", pWidth,
-                 pHeight);
-
-    int32_t *i;
-    wl_array_for_each(i, s)
-    {
-        switch (*i)
-        {
-            case 2:
-                primrose_log(VERBOSE, "The window is now fullscreened.");
-                break;
-            case 4:
-                primrose_log(VERBOSE, "The window is now activated.");
-                break;
-            case 9: primrose_log(NOTE, "The window is now suspended."); break;
-            default:
-                primrose_log(WARNING, "Got unknown state value '%d'.", *i);
-                break;
-        }
-    }
-}
+/**
+ * @var uint64_t pLastPresented
+ * @brief The time at which the most recent frame was presented, which is the
+ * anchor of our vertical retrace prediction.
+ * @since v0.0.0.48
+ */
+static _Atomic uint64_t pLastPresented = 0;
 
 /**
- * @copydoc xdg_toplevel_listener::close
+ * @var uint32_t pLastRefresh
+ * @brief The refresh interval reported alongside @ref pLastPresented, in
+ * nanoseconds.
+ * @since v0.0.0.48
  */
-static void close(void *, struct xdg_toplevel *)
-{
-    primrose_log(NOTE, "Closing window.");
-    pClose = true;
-}
+static _Atomic uint32_t pLastRefresh = 0;
 
 /**
- * @copydoc xdg_toplevel_listener::bounds
+ * @var struct wl_shm *pShm
+ * @brief The shared memory object, through which we hand CPU-drawn pixels to
+ * the compositor. This is optional; without it there's no software path.
+ * @since v0.0.0.50
  */
-static void bounds(void *, struct xdg_toplevel *, int32_t, int32_t) {}
+static struct wl_shm *pShm = nullptr;
 
 /**
- * @copydoc xdg_toplevel_listener::capabilities
+ * @def SWAPCHAIN_MAX
+ * @brief The maximum number of shared memory buffers we allocate. Beyond four,
+ * the extra buffers only add latency.
+ * @since v0.0.0.51
  */
-static void capabilities(void *, struct xdg_toplevel *, struct wl_array *c)
-{
-    int32_t *i;
-    wl_array_for_each(i, c) if (*i == 3)
-    {
-        primrose_log(VERBOSE_OK, "Found fullscreen support.");
-        return;
-    }
+#define SWAPCHAIN_MAX 4
 
-    primrose_log(ERROR, "No fullscreen support available.");
-}
+/**
+ * @var uint32_t pSwapchainDepth
+ * @brief The number of shared memory buffers the application asked for. Two
+ * is the minimum to never draw into a buffer the compositor is reading.
+ * @since v0.0.0.51
+ */
+static uint32_t pSwapchainDepth = 3;
 
 /**
- * @struct xdg_toplevel_listener Wayland.c "Source/Wayland.c"
- * @brief An interface for handling events for the @c xdg_toplevel structure.
- * This provides a bunch of information about surface dimensions, capabilities,
- * and more.
- * @since v0.0.0.20
+ * @struct shm_buffer Wayland.c "Source/Wayland.c"
+ * @brief A single buffer carved out of the shared memory pool.
+ * @since v0.0.0.50
  */
-static const struct xdg_toplevel_listener
+struct shm_buffer
 {
     /**
-     * @property topConfigure
-     * @brief This configure event asks the client to resize its toplevel
-     * surface or to change its state. The width and height arguments specify a
-     * hint to the window about how its surface should be resized in window
-     * geometry coordinates. The states listed in the event specify how the
-     * width/height arguments should be interpreted, and possibly how it should
-     * be drawn.
-     * @since v0.0.0.20
-     *
-     * @remark If the width or height arguments are zero, it means the client
-     * should decide its own window dimension. This may happen when the
-     * compositor needs to configure the state of the surface but doesn’t have
-     * any information about any previous or expected dimension.
-     *
-     * @param[in] data Any data asked to have been sent alongside the toplevel.
-     * @param[in] toplevel The toplevel this configuration event was sent for.
-     * @param[in] width The suggested width of the window in screen coordinates.
-     * @param[in] height The suggested height of the window in screen
-     * coordinates.
-     * @param[in] states An array of states to use for dealing with the provided
-     * width and height or general window rendering.
+     * @property buffer
+     * @brief The buffer object, or @c nullptr if not allocated.
+     * @since v0.0.0.50
      */
-    void (*topConfigure)(void *data, struct xdg_toplevel *toplevel,
-                         int32_t width, int32_t height,
-                         struct wl_array *states);
-
+    struct wl_buffer *buffer;
     /**
-     * @property close
-     * @brief The close event is sent by the compositor when the user wants the
-     * surface to be closed.
-     * @since v0.0.0.20
-     *
-     * @remark This is only a request that the user intends to close the window.
-     * The client may choose to ignore this request, or show a dialog to ask the
-     * user to save their data, etc.
-     *
-     * @param[in] data Any data asked to have been sent alongside the toplevel.
-     * @param[in] toplevel The toplevel that wishes to be closed.
+     * @property pixels
+     * @brief Where the buffer begins within our mapping of the pool.
+     * @since v0.0.0.50
      */
-    void (*close)(void *data, struct xdg_toplevel *toplevel);
-
+    void *pixels;
     /**
-     * @property bounds
-     * @brief The configure_bounds event may be sent prior to a configure event
-     * to communicate the bounds a window geometry size is recommended to
-     * constrain to. The bounds can for example correspond to the size of a
-     * monitor excluding any panels or other shell components, so that a surface
-     * isn't created in a way that it cannot fit.
-     * @since v0.0.0.20
-     *
-     * @remarks If width and height are 0, it means bounds is unknown and
-     * equivalent to as if no configure_bounds event was ever sent for this
-     * surface.
-     *
-     * @param[in] data Any data asked to have been sent alongside the toplevel.
-     * @param[in] toplevel The toplevel this event was sent for.
-     * @param[in] width The constrain width in screen coordinates.
-     * @param[in] height The constrain height in screen coordinates.
+     * @property width
+     * @brief The width the buffer was cut at, in pixels.
+     * @since v0.0.0.69
      */
-    void (*bounds)(void *data, struct xdg_toplevel *toplevel, int32_t width,
-                   int32_t height);
-
+    uint32_t width;
     /**
-     * @property capabilities
-     * @brief This event advertises the capabilities supported by the
-     * compositor. If a capability isn't supported, clients should hide or
-     * disable the UI elements that expose this functionality. The
-     * compositor will ignore requests it doesn't support. Compositors must send
-     * this event once before the first xdg_surface.configure event. When the
-     * capabilities change, compositors must send this event again and then send
-     * a configure event.
-     * @since v0.0.0.20
-     *
-     * @remarks The capabilities are sent as an array of 32-bit unsigned
-     * integers in native endianness.
-     *
-     * @param[in] data Any data asked to have been sent alongside the toplevel.
-     * @param[in] toplevel The toplevel this event was sent for.
-     * @param[in] capabilities An array of the compositor's advertised
-     * capabilities.
+     * @property height
+     * @brief The height the buffer was cut at, in pixels.
+     * @since v0.0.0.69
      */
-    void (*capabilities)(void *data, struct xdg_toplevel *toplevel,
-                         struct wl_array *capabilities);
-}
+    uint32_t height;
+    /**
+     * @property format
+     * @brief The format the buffer was cut in, as a @c wl_shm format code.
+     * @since v0.0.0.69
+     */
+    uint32_t format;
+    /**
+     * @property frame
+     * @brief The number of the frame this buffer last presented, counted by
+     * @ref pPresentCount, or zero if it never has been.
+     * @since v0.0.0.52
+     */
+    uint64_t frame;
+    /**
+     * @property busy
+     * @brief Whether or not the compositor may still be reading the buffer.
+     * @since v0.0.0.50
+     */
+    _Atomic bool busy;
+};
+
 /**
- * @var struct xdg_toplevel_listener pToplevelListener
- * @brief The listener for the XDG toplevel surface object. This handles
- * configuration events and close requests.
- * @since v0.0.0.2
- *
- * @copydoc xdg_toplevel_listener
+ * @var struct shm_buffer pShmBuffers
+ * @brief The shared memory buffers, all of which live in @ref pShmPool.
+ * @since v0.0.0.50
  */
-pToplevelListener = {&topConfigure, &close, &bounds, &capabilities};
+static struct shm_buffer pShmBuffers[SWAPCHAIN_MAX] = {0};
 
 /**
- * @copydoc wl_output_listener::geometry
+ * @def SHM_ORPHANS
+ * @brief The most buffers of replaced pools we keep waiting on. Every one but
+ * the newest has been superseded, so a full list is sure to drain.
+ * @since v0.0.0.69
  */
-static void geometry(void *, struct wl_output *, int32_t, int32_t, int32_t,
-                     int32_t, int32_t, const char *, const char *, int32_t)
-{
-}
+#define SHM_ORPHANS (SWAPCHAIN_MAX * 2)
 
 /**
- * @copydoc wl_output_listener::mode
+ * @var struct wl_buffer *pShmOrphans
+ * @brief The buffers of pools since replaced that the compositor was still
+ * reading at the time. Each is destroyed once it's released, and not before.
+ * @since v0.0.0.69
  */
-static void mode(void *, struct wl_output *, uint32_t, int32_t, int32_t,
-                 int32_t)
-{
-}
+static struct wl_buffer *pShmOrphans[SHM_ORPHANS] = {0};
 
 /**
- * @copydoc wl_output_listener::finish
+ * @var struct wl_shm_pool *pShmPool
+ * @brief The pool, backed by a single @c memfd, that all buffers live in.
+ * @since v0.0.0.50
  */
-static void finish(void *, struct wl_output *) {}
+static struct wl_shm_pool *pShmPool = nullptr;
 
 /**
- * @copydoc wl_output_listener::scale
+ * @var void *pShmMemory
+ * @brief Our own mapping of the pool's memory.
+ * @since v0.0.0.50
  */
-static void scale(void *, struct wl_output *, int32_t s)
-{
-    pScale = s;
-    primrose_log(VERBOSE, "Monitor scale %d.", pScale);
-}
+static void *pShmMemory = nullptr;
 
 /**
- * @copydoc wl_output_listener::name
+ * @var size_t pShmSize
+ * @brief The size of the pool in bytes.
+ * @since v0.0.0.50
  */
-static void name(void *, struct wl_output *, const char *) {}
+static size_t pShmSize = 0;
 
 /**
- * @copydoc wl_output_listener::description
+ * @var size_t pShmSlot
+ * @brief The bytes of the pool set aside for each buffer; the buffer in slot
+ * @c i always begins @c i times this into the pool, whatever its size. This
+ * only changes along with the pool, so a resize never moves a buffer over
+ * memory the compositor may still be reading.
+ * @since v0.0.0.69
  */
-static void description(void *, struct wl_output *, const char *) {}
+static size_t pShmSlot = 0;
 
 /**
- * @var struct wl_output_listener pOutputListener
- * @brief The listener for the Wayland output object. This is nearly always a
- * monitor, but is @b always a graphical output device of some kind. We don't
- * care what it is; we're gonna send all our data to it anyway!
- * @since v0.0.0.2
+ * @var uint32_t pShmWidth
+ * @brief The width of the buffers currently in the pool, in pixels.
+ * @since v0.0.0.50
  */
-static const struct wl_output_listener pOutputListener = {
-    &geometry, &mode, &finish, &scale, &name, &description};
+static uint32_t pShmWidth = 0;
 
 /**
- * @copydoc wl_registry_listener::global
+ * @var uint32_t pShmHeight
+ * @brief The height of the buffers currently in the pool, in pixels.
+ * @since v0.0.0.50
  */
-static void global(void *, struct wl_registry *registry, uint32_t name,
-                   const char *interface, uint32_t version)
-{
-    if (__builtin_expect(pFoundInterfaces == pRequiredInterfaces, true)) return;
+static uint32_t pShmHeight = 0;
 
-    if (strcmp(interface, wl_compositor_interface.name) == 0)
-    {
-        pCompositor =
-            wl_registry_bind(registry, name, &wl_compositor_interface, version);
-        pFoundInterfaces++;
-        primrose_log(VERBOSE_OK, "Connected to compositor v%d.", version);
-        return;
-    }
-    else if (strcmp(interface, "xdg_wm_base") == 0)
-    {
-        pShell = wl_registry_bind(registry, name, &pXDGShellInterface, version);
-        // xdg_wm_base_add_listener
-        (void)wl_proxy_add_listener((struct wl_proxy *)pShell,
-                                    (void (**)(void))&pShellListener, nullptr);
-        pFoundInterfaces++;
-        primrose_log(VERBOSE_OK, "Connected to window manager v%d.", version);
-        return;
-    }
-    else if (strcmp(interface, wl_output_interface.name) == 0)
-    {
-        pOutput =
-            wl_registry_bind(registry, name, &wl_output_interface, version);
-        (void)wl_output_add_listener(pOutput, &pOutputListener, nullptr);
-        pFoundInterfaces++;
-        primrose_log(VERBOSE_OK, "Connected to output device v%d.", version);
-        return;
-    }
+/**
+ * @var uint32_t pShmDepth
+ * @brief The number of buffers currently in the pool.
+ * @since v0.0.0.51
+ */
+static uint32_t pShmDepth = 0;
 
-    primrose_log(VERBOSE, "Found unknown interface '%s'.", interface);
-}
+/**
+ * @var hyacinth_swapchain_stats pSwapchainStats
+ * @brief The counters of the software swapchain.
+ * @since v0.0.0.51
+ */
+static hyacinth_swapchain_stats pSwapchainStats = {0};
 
 /**
- * @copydoc wl_registry_listener::global_remove
+ * @var uint64_t pPresentCount
+ * @brief The number of frames ever presented through the software path, from
+ * which the age of each buffer is derived.
+ * @since v0.0.0.52
  */
-static void globalRemove(void *, struct wl_registry *, uint32_t) {}
+static uint64_t pPresentCount = 0;
 
 /**
- * @var struct wl_registry_listener pRegistryListener
- * @brief The listener for the Wayland registry object, through which we handle
- * all base objects such as the XDG window manager base object or the output
- * object.
- * @since v0.0.0.2
+ * @def DAMAGE_MAX
+ * @brief The most rectangles of damage we track per frame. Past this, the
+ * bookkeeping costs more than it saves, and the whole buffer is damaged.
+ * @since v0.0.0.52
  */
-static const struct wl_registry_listener pRegistryListener = {&global,
-                                                              &globalRemove};
+#define DAMAGE_MAX 16
 
-bool hyacinth_create(const char *title)
+/**
+ * @struct damage Wayland.c "Source/Wayland.c"
+ * @brief The damage accumulated for the frame being drawn.
+ * @since v0.0.0.52
+ */
+static struct damage
 {
-    pDisplay = wl_display_connect(nullptr);
-    if (__builtin_expect(pDisplay == nullptr, false))
-    {
-        primrose_log(ERROR, "Failed to connect to display server.");
-        return false;
-    }
+    /**
+     * @property rects
+     * @brief The damaged rectangles, none of which are worth merging.
+     * @since v0.0.0.52
+     */
+    hyacinth_rect rects[DAMAGE_MAX];
+    /**
+     * @property count
+     * @brief The number of valid rectangles.
+     * @since v0.0.0.52
+     */
+    uint32_t count;
+    /**
+     * @property full
+     * @brief Whether or not we've given up and damaged everything.
+     * @since v0.0.0.52
+     */
+    bool full;
+}
+/**
+ * @var struct damage pDamage
+ * @brief The damage of the frame being drawn.
+ * @since v0.0.0.52
+ */
+pDamage = {0};
 
-    pRegistry = wl_display_get_registry(pDisplay);
-    (void)wl_registry_add_listener(pRegistry, &pRegistryListener, nullptr);
-    (void)wl_display_roundtrip(pDisplay);
-    if (__builtin_expect(pFoundInterfaces != pRequiredInterfaces, false))
-    {
-        primrose_log(ERROR, "Could not find the required interfaces.");
-        return false;
-    }
+/**
+ * @var uint32_t pShmFormat
+ * @brief The pixel format of the buffers currently in the pool, as a @c wl_shm
+ * format code.
+ * @since v0.0.0.50
+ */
+static uint32_t pShmFormat = WL_SHM_FORMAT_ARGB8888;
 
-    pSurface = wl_compositor_create_surface(pCompositor);
-    // xdg_wm_base_get_xdg_surface
-    pShellSurface = (struct xdg_surface *)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pShell, 2, &pXDGSurfaceInterface,
-        wl_proxy_get_version((struct wl_proxy *)pShell), 0, nullptr, pSurface);
-    // xdg_surface_add_listener
-    (void)wl_proxy_add_listener((struct wl_proxy *)pShellSurface,
-                                (void (**)(void))&pShellSurfaceListener,
-                                nullptr);
-    // xdg_surface_get_toplevel
-    pToplevel = (struct xdg_toplevel *)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pShellSurface, 1, &pXDGToplevelInterface,
-        wl_proxy_get_version((struct wl_proxy *)pShellSurface), 0, nullptr);
-    // xdg_toplevel_add_listener
-    (void)wl_proxy_add_listener((struct wl_proxy *)pToplevel,
-                                (void (**)(void))&pToplevelListener, nullptr);
+/**
+ * @var bool pOpaque
+ * @brief Whether or not the whole window is declared opaque, in which case the
+ * pool is allocated without an alpha channel.
+ * @since v0.0.0.53
+ */
+static bool pOpaque = true;
 
-    // xdg_toplevel_set_title
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pToplevel, 2, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, title);
-    // xdg_toplevel_set_app_id
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pToplevel, 3, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, title);
-    // xdg_toplevel_set_fullscreen
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pToplevel, 11, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, pOutput);
+/**
+ * @var int32_t pAcquired
+ * @brief The index of the buffer currently held by the application, or -1 if
+ * none is.
+ * @since v0.0.0.50
+ */
+static int32_t pAcquired = -1;
 
-    return true;
-}
+/**
+ * @var struct wl_seat *pSeat
+ * @brief The seat, or group of input devices, we receive input from. Only the
+ * first seat advertised is used; multi-seat setups are vanishingly rare.
+ * @since v0.0.0.54
+ */
+static struct wl_seat *pSeat = nullptr;
 
-void hyacinth_destroy(void)
-{
-    // xdg_toplevel_destroy
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pToplevel, 0, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pToplevel),
-        WL_MARSHAL_FLAG_DESTROY);
-    // xdg_surface_destroy
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pShellSurface, 0, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pShellSurface),
-        WL_MARSHAL_FLAG_DESTROY);
-    // xdg_wm_base_destroy
-    (void)wl_proxy_marshal_flags(
-        (struct wl_proxy *)pShell, 0, nullptr,
-        wl_proxy_get_version((struct wl_proxy *)pShell),
-        WL_MARSHAL_FLAG_DESTROY);
+/**
+ * @var struct wl_pointer *pPointer
+ * @brief The pointer of the seat, if it has one.
+ * @since v0.0.0.54
+ */
+static struct wl_pointer *pPointer = nullptr;
 
-    wl_surface_destroy(pSurface);
-    wl_compositor_destroy(pCompositor);
-    wl_output_release(pOutput);
-    wl_registry_destroy(pRegistry);
-    wl_display_disconnect(pDisplay);
-}
+/**
+ * @var struct wl_keyboard *pKeyboard
+ * @brief The keyboard of the seat, if it has one.
+ * @since v0.0.0.54
+ */
+static struct wl_keyboard *pKeyboard = nullptr;
 
-bool hyacinth_process(void)
-{
-    return wl_display_dispatch(pDisplay) != -1 && !pClose;
+/**
+ * @var struct wl_touch *pTouch
+ * @brief The touchscreen of the seat, if it has one.
+ * @since v0.0.0.54
+ */
+static struct wl_touch *pTouch = nullptr;
+
+/**
+ * @var struct zwp_relative_pointer_manager_v1 *pRelativeManager
+ * @brief The relative pointer manager, if the compositor has one.
+ * @since v0.0.0.56
+ */
+static struct zwp_relative_pointer_manager_v1 *pRelativeManager = nullptr;
+
+/**
+ * @var struct zwp_relative_pointer_v1 *pRelativePointer
+ * @brief The relative pointer of @ref pPointer, through which raw motion
+ * arrives.
+ * @since v0.0.0.56
+ */
+static struct zwp_relative_pointer_v1 *pRelativePointer = nullptr;
+
+/**
+ * @var bool pWantRelative
+ * @brief Whether the application asked for relative motion. Without that, the
+ * relative pointer only exists while the pointer is locked; otherwise, every
+ * movement of the mouse would wake us twice.
+ * @since v0.0.0.69
+ */
+static bool pWantRelative = false;
+
+/**
+ * @var struct zwp_pointer_constraints_v1 *pConstraints
+ * @brief The pointer constraints object, if the compositor has one.
+ * @since v0.0.0.56
+ */
+static struct zwp_pointer_constraints_v1 *pConstraints = nullptr;
+
+/**
+ * @var struct wl_proxy *pConstraint
+ * @brief The active lock or confinement of the pointer, if any.
+ * @since v0.0.0.56
+ */
+static struct wl_proxy *pConstraint = nullptr;
+
+/**
+ * @var bool pLocked
+ * @brief Whether @ref pConstraint is a lock, as opposed to a confinement.
+ * @since v0.0.0.56
+ */
+static bool pLocked = false;
+
+/**
+ * @var struct zwp_input_timestamps_manager_v1 *pTimestampsManager
+ * @brief The input timestamps manager, if the compositor has one.
+ * @since v0.0.0.57
+ */
+static struct zwp_input_timestamps_manager_v1 *pTimestampsManager = nullptr;
+
+/**
+ * @struct input_timestamps Wayland.c "Source/Wayland.c"
+ * @brief The precise timestamps of a single input device.
+ * @since v0.0.0.57
+ */
+struct input_timestamps
+{
+    /**
+     * @property proxy
+     * @brief The timestamps object, if subscribed.
+     * @since v0.0.0.57
+     */
+    struct wl_proxy *proxy;
+    /**
+     * @property time
+     * @brief The timestamp of the device's upcoming event in nanoseconds, or
+     * zero if none was sent.
+     * @since v0.0.0.57
+     */
+    uint64_t time;
+};
+
+/**
+ * @var struct input_timestamps pKeyboardTimestamps
+ * @brief The precise timestamps of @ref pKeyboard.
+ * @since v0.0.0.57
+ */
+static struct input_timestamps pKeyboardTimestamps = {0},
+/**
+ * @var struct input_timestamps pPointerTimestamps
+ * @brief The precise timestamps of @ref pPointer.
+ * @since v0.0.0.57
+ */
+pPointerTimestamps = {0},
+/**
+ * @var struct input_timestamps pTouchTimestamps
+ * @brief The precise timestamps of @ref pTouch.
+ * @since v0.0.0.57
+ */
+pTouchTimestamps = {0};
+
+/**
+ * @def KEYMAP_KEYS
+ * @brief The number of XKB keycodes covered by the keysym table. This covers
+ * every Linux input event code below 248, which is every key on every keyboard
+ * one is likely to meet.
+ * @since v0.0.0.58
+ */
+#define KEYMAP_KEYS 256
+
+/**
+ * @def KEYMAP_LEVELS
+ * @brief The number of modifier combinations covered by the keysym table; one
+ * for each combination of Shift, Lock, and the third-level modifier.
+ * @since v0.0.0.58
+ *
+ * @remark As of v0.0.0.69, NumLock is covered too, without which the keypad
+ * only ever produced its navigation keysyms.
+ */
+#define KEYMAP_LEVELS 16
+
+/**
+ * @def KEYMAP_MAGIC
+ * @brief The identifier at the start of every cached keysym table. This must
+ * change whenever the layout of @ref keymap_table does.
+ * @since v0.0.0.58
+ */
+#define KEYMAP_MAGIC 0x334B5948
+
+/**
+ * @def KEYMAP_XKB
+ * @brief The release of xkbcommon keymaps are compiled with. A newer
+ * xkbcommon may well compile the same keymap differently, so cached tables
+ * must not outlive it. This is @c XKBCOMMON_VERSION should the build define
+ * it, e.g. from @c pkg-config, and otherwise the time of the build, so that at
+ * least no table outlives the binary that made it.
+ * @since v0.0.0.69
+ */
+#ifdef XKBCOMMON_VERSION
+#define KEYMAP_XKB XKBCOMMON_VERSION
+#else
+#define KEYMAP_XKB __DATE__ " " __TIME__
+#endif
+
+/**
+ * @def KEYMAP_CACHED
+ * @brief The most keysym tables kept in the cache. Beyond this, those used
+ * least recently are deleted.
+ * @since v0.0.0.69
+ */
+#define KEYMAP_CACHED 16
+
+/**
+ * @struct keymap_table Wayland.c "Source/Wayland.c"
+ * @brief A keymap compiled down to a flat table of keysyms, so that resolving
+ * a key press costs one load. This is exactly what is cached on disk, so it
+ * can be mapped straight back in.
+ * @since v0.0.0.58
+ */
+struct keymap_table
+{
+    /**
+     * @property magic
+     * @brief Always @ref KEYMAP_MAGIC.
+     * @since v0.0.0.58
+     */
+    uint32_t magic;
+    /**
+     * @property layouts
+     * @brief The number of layouts, or groups, within the table.
+     * @since v0.0.0.58
+     */
+    uint32_t layouts;
+    /**
+     * @property hash
+     * @brief The hash of the keymap text this was compiled from.
+     * @since v0.0.0.58
+     */
+    uint64_t hash;
+    /**
+     * @property shift
+     * @brief The mask of the Shift modifier, or zero if there is none.
+     * @since v0.0.0.58
+     */
+    uint32_t shift;
+    /**
+     * @property lock
+     * @brief The mask of the Lock modifier, or zero if there is none.
+     * @since v0.0.0.58
+     */
+    uint32_t lock;
+    /**
+     * @property level3
+     * @brief The mask of the third-level modifier, or zero if there is none.
+     * @since v0.0.0.58
+     */
+    uint32_t level3;
+    /**
+     * @property num
+     * @brief The mask of the NumLock modifier, or zero if there is none.
+     * @since v0.0.0.69
+     */
+    uint32_t num;
+    /**
+     * @property repeats
+     * @brief A bit for every keycode, set if the key repeats when held.
+     * @since v0.0.0.59
+     */
+    uint32_t repeats[KEYMAP_KEYS / 32];
+    /**
+     * @property keysyms
+     * @brief The keysyms of every key, per layout, keycode, and modifier
+     * combination.
+     * @since v0.0.0.58
+     */
+    uint32_t keysyms[][KEYMAP_KEYS][KEYMAP_LEVELS];
+};
+
+/**
+ * @var struct keymap_table *pKeymap
+ * @brief The keysym table of the current keymap, either mapped from the cache
+ * or allocated.
+ * @since v0.0.0.58
+ */
+static struct keymap_table *pKeymap = nullptr;
+
+/**
+ * @var size_t pKeymapSize
+ * @brief The size of @ref pKeymap in bytes.
+ * @since v0.0.0.58
+ */
+static size_t pKeymapSize = 0;
+
+/**
+ * @var bool pKeymapMapped
+ * @brief Whether @ref pKeymap was mapped from the cache, rather than
+ * allocated.
+ * @since v0.0.0.58
+ */
+static bool pKeymapMapped = false;
+
+/**
+ * @var uint64_t pXkbVersion
+ * @brief The hash identifying the keysym tables this build makes, which every
+ * keymap hash starts from, or zero until it's first needed.
+ * @since v0.0.0.69
+ */
+static uint64_t pXkbVersion = 0;
+
+/**
+ * @var uint32_t pModifiers
+ * @brief The effective modifiers of the keyboard.
+ * @since v0.0.0.58
+ */
+static uint32_t pModifiers = 0;
+
+/**
+ * @var uint32_t pGroup
+ * @brief The effective layout of the keyboard.
+ * @since v0.0.0.58
+ */
+static uint32_t pGroup = 0;
+
+/**
+ * @var int pRepeatFD
+ * @brief The timer that drives key repeat. This is waited upon alongside the
+ * connection, wherever that happens.
+ * @since v0.0.0.59
+ */
+static int pRepeatFD = -1;
+
+/**
+ * @var int32_t pRepeatRate
+ * @brief The rate of key repeat in keys per second, or zero if keys should not
+ * repeat at all. Until the compositor says otherwise, this is the common
+ * default.
+ * @since v0.0.0.59
+ */
+static int32_t pRepeatRate = 25;
+
+/**
+ * @var int32_t pRepeatDelay
+ * @brief The delay before a held key starts repeating, in milliseconds.
+ * @since v0.0.0.59
+ */
+static int32_t pRepeatDelay = 600;
+
+/**
+ * @var uint32_t pRepeatKey
+ * @brief The key being repeated, or zero (@c KEY_RESERVED, which is never
+ * sent) if none is.
+ * @since v0.0.0.59
+ */
+static uint32_t pRepeatKey = 0;
+
+/**
+ * @var uint64_t pRepeatNext
+ * @brief The time at which the next repeat is due, as per @ref
+ * hyacinth_getTime.
+ * @since v0.0.0.59
+ */
+static uint64_t pRepeatNext = 0;
+
+/**
+ * @var int32_t pScale
+ * @brief The monitor scale of screen coordinates to pixels. This is nearly
+ * always one, unless on a display like the Apple Retina.
+ * @since v0.0.0.2
+ *
+ * @remark As of v0.0.0.60, this is the largest scale of the outputs the window
+ * is on, or of all outputs if it is on none yet.
+ *
+ * @remark As of v0.0.0.69, the compositor's preferred scale wins, if it has
+ * told us one.
+ */
+static int32_t pScale = 1;
+
+/**
+ * @var int32_t pPreferredScale
+ * @brief The buffer scale the compositor would have the window use, or zero
+ * if it hasn't said.
+ * @since v0.0.0.69
+ */
+static int32_t pPreferredScale = 0;
+
+/**
+ * @var struct wp_viewporter *pViewporter
+ * @brief The viewporter, if the compositor has one.
+ * @since v0.0.0.62
+ */
+static struct wp_viewporter *pViewporter = nullptr;
+
+/**
+ * @var struct wp_viewport *pViewport
+ * @brief The viewport of @ref pSurface. While this exists, it maps our buffers
+ * onto the window, whatever their size, and the buffer scale is left at one.
+ * @since v0.0.0.62
+ */
+static struct wp_viewport *pViewport = nullptr;
+
+/**
+ * @var struct wp_fractional_scale_manager_v1 *pFractionalManager
+ * @brief The fractional scale manager, if the compositor has one.
+ * @since v0.0.0.62
+ */
+static struct wp_fractional_scale_manager_v1 *pFractionalManager = nullptr;
+
+/**
+ * @var struct wp_fractional_scale_v1 *pFractionalScale
+ * @brief The fractional scale object of @ref pSurface.
+ * @since v0.0.0.62
+ */
+static struct wp_fractional_scale_v1 *pFractionalScale = nullptr;
+
+/**
+ * @var uint32_t pScale120
+ * @brief The preferred scale of the window in 120ths, or zero if the
+ * compositor has not told us one; then @ref pScale is used.
+ * @since v0.0.0.62
+ */
+static _Atomic uint32_t pScale120 = 0;
+
+/**
+ * @var uint32_t pLogicalWidth
+ * @brief The width of the window in screen coordinates, as configured.
+ * @since v0.0.0.62
+ */
+static uint32_t pLogicalWidth = 0;
+
+/**
+ * @var uint32_t pLogicalHeight
+ * @brief The height of the window in screen coordinates, as configured.
+ * @since v0.0.0.62
+ */
+static uint32_t pLogicalHeight = 0;
+
+/**
+ * @var uint32_t pPendingWidth
+ * @brief The width of the latest configuration, not yet applied.
+ * @since v0.0.0.64
+ */
+static uint32_t pPendingWidth = 0;
+
+/**
+ * @var uint32_t pPendingHeight
+ * @brief The height of the latest configuration, not yet applied.
+ * @since v0.0.0.64
+ */
+static uint32_t pPendingHeight = 0;
+
+/**
+ * @var uint32_t pPendingSerial
+ * @brief The serial of the latest configuration, to be acknowledged once it
+ * is applied.
+ * @since v0.0.0.64
+ */
+static uint32_t pPendingSerial = 0;
+
+/**
+ * @var bool pConfigurePending
+ * @brief Whether or not a configuration is waiting to be applied.
+ * @since v0.0.0.64
+ */
+static bool pConfigurePending = false;
+
+/**
+ * @var uint64_t pAck
+ * @brief The serial of the latest configuration applied, tagged with bit 32 so
+ * that zero means there hasn't been one. The acknowledgement itself is left to
+ * the application's thread, see @ref ackConfigure.
+ * @since v0.0.0.69
+ */
+static _Atomic uint64_t pAck = 0;
+
+/**
+ * @var uint64_t pAcked
+ * @brief The last value of @ref pAck to be acknowledged. Acknowledging the
+ * same configuration twice is a protocol error.
+ * @since v0.0.0.69
+ */
+static uint64_t pAcked = 0;
+
+/**
+ * @var uint64_t pAcquiredAck
+ * @brief The value of @ref pAck when the buffer currently held was acquired,
+ * and so the configuration whose size that buffer was made for.
+ * @since v0.0.0.69
+ */
+static uint64_t pAcquiredAck = 0;
+
+/**
+ * @var bool pRescaled
+ * @brief Whether or not the scale has changed since the window was last
+ * resized.
+ * @since v0.0.0.64
+ */
+static bool pRescaled = false;
+
+/**
+ * @var uint64_t pSizeGeneration
+ * @brief The number of times the size of the window in pixels has changed.
+ * @since v0.0.0.64
+ */
+static _Atomic uint64_t pSizeGeneration = 0;
+
+/**
+ * @var uint32_t pPendingStates
+ * @brief The states of the latest configuration, as @c HYACINTH_STATE_* bits.
+ * @since v0.0.0.65
+ */
+static uint32_t pPendingStates = 0;
+
+/**
+ * @var uint32_t pStates
+ * @brief The states of the window currently applied.
+ * @since v0.0.0.65
+ */
+static _Atomic uint32_t pStates = 0;
+
+/**
+ * @var bool pThrottle
+ * @brief Whether or not to stop doing work while the window is suspended.
+ * @since v0.0.0.65
+ */
+static bool pThrottle = false;
+
+/**
+ * @var uint32_t pRenderWidth
+ * @brief The width the application renders at in pixels, or zero to render at
+ * @ref pWidth.
+ * @since v0.0.0.63
+ */
+static _Atomic uint32_t pRenderWidth = 0;
+
+/**
+ * @var uint32_t pRenderHeight
+ * @brief The height the application renders at in pixels, or zero to render
+ * at @ref pHeight.
+ * @since v0.0.0.63
+ */
+static _Atomic uint32_t pRenderHeight = 0;
+
+/**
+ * @var uint32_t pDestWidth
+ * @brief The width the window is shown at in screen coordinates, or zero to
+ * show it at @ref pLogicalWidth.
+ * @since v0.0.0.63
+ */
+static _Atomic uint32_t pDestWidth = 0;
+
+/**
+ * @var uint32_t pDestHeight
+ * @brief The height the window is shown at in screen coordinates, or zero to
+ * show it at @ref pLogicalHeight.
+ * @since v0.0.0.63
+ */
+static _Atomic uint32_t pDestHeight = 0;
+
+/**
+ * @var uint32_t pWidth
+ * @brief The width of the window in @b pixels. This value is recieved from the
+ * display server and multiplied by @ref pScale to grab the actual pixel
+ * value.
+ * @since v0.0.0.2
+ *
+ * @remark As of v0.0.0.62, this is multiplied by @ref pScale120 instead, where
+ * fractional scaling is possible.
+ */
+static _Atomic uint32_t pWidth = 0;
+
+/**
+ * @var uint32_t pHeight
+ * @brief The height of the window in @b pixels. This value is recieved from the
+ * display server and multiplied by @ref pScale to grab the actual pixel
+ * value.
+ * @since v0.0.0.2
+ */
+static _Atomic uint32_t pHeight = 0;
+
+/**
+ * @var uint8_t pFoundInterfaces
+ * @brief A count of the interfaces we've found reported by the registry. This
+ * must match @ref pRequiredInterfaces, or the process will throw a
+ * tantrum.
+ * @since v0.0.0.35
+ */
+static uint8_t pFoundInterfaces = 0;
+
+/**
+ * @var uint8_t pRequiredInterfaces
+ * @brief A count of the interfaces that the registry @b must report and connect
+ * to in order for the process to complete its work successfully.
+ * @since v0.0.0.35
+ */
+static const uint8_t pRequiredInterfaces = 3;
+
+/**
+ * @def EVENT_RING
+ * @brief The number of events the event ring can hold. This must be a power of
+ * two, and should comfortably cover a frame's worth of input.
+ * @since v0.0.0.49
+ */
+#define EVENT_RING 1024
+
+static_assert(sizeof(hyacinth_event) <= 32, "Events must fit in 32 bytes.");
+
+/**
+ * @struct event_ring Wayland.c "Source/Wayland.c"
+ * @brief A single-producer, single-consumer ring of events. The producer is
+ * whoever dispatches Wayland events, and the consumer whoever calls @ref
+ * hyacinth_nextEvent (or @ref hyacinth_nextMotion). Each side's index lives
+ * on its own cache line alongside its cached copy of the other side's index,
+ * so in the common case neither side touches a line the other is writing.
+ * @since v0.0.0.49
+ */
+static struct event_ring
+{
+    /**
+     * @property head
+     * @brief The count of events ever written. Only the producer stores this.
+     * @since v0.0.0.49
+     */
+    alignas(64) _Atomic uint32_t head;
+    /**
+     * @property tailCache
+     * @brief The producer's last look at @ref tail.
+     * @since v0.0.0.49
+     */
+    uint32_t tailCache;
+    /**
+     * @property overflowed
+     * @brief Whether or not the ring is currently dropping events, so that we
+     * only complain once per overflow.
+     * @since v0.0.0.49
+     */
+    bool overflowed;
+    /**
+     * @property tail
+     * @brief The count of events ever read. Only the consumer stores this.
+     * @since v0.0.0.49
+     */
+    alignas(64) _Atomic uint32_t tail;
+    /**
+     * @property headCache
+     * @brief The consumer's last look at @ref head.
+     * @since v0.0.0.49
+     */
+    uint32_t headCache;
+    /**
+     * @property events
+     * @brief The storage of the ring, indexed modulo @ref EVENT_RING.
+     * @since v0.0.0.49
+     */
+    alignas(64) hyacinth_event events[EVENT_RING];
+}
+/**
+ * @var struct event_ring pEvents
+ * @brief The ring of events delivered through @ref hyacinth_nextEvent.
+ * @since v0.0.0.49
+ */
+pEvents = {0},
+/**
+ * @var struct event_ring pMotionHistory
+ * @brief The ring of every pointer motion event merged away while coalescing,
+ * delivered through @ref hyacinth_nextMotion.
+ * @since v0.0.0.55
+ */
+pMotionHistory = {0};
+
+/**
+ * @var hyacinth_event pPointerFrame
+ * @brief The pointer event being assembled from the events of the current @c
+ * wl_pointer frame. Its flags tell which parts have arrived so far; the
+ * position is kept between frames.
+ * @since v0.0.0.55
+ */
+static hyacinth_event pPointerFrame = {.type = HYACINTH_EVENT_POINTER};
+
+/**
+ * @var bool pCoalesce
+ * @brief Whether or not consecutive motion-only pointer events are merged.
+ * @since v0.0.0.55
+ */
+static _Atomic bool pCoalesce = false;
+
+/**
+ * @var bool pKeepHistory
+ * @brief Whether or not motion merged away is kept in @ref pMotionHistory.
+ * @since v0.0.0.55
+ */
+static _Atomic bool pKeepHistory = false;
+
+/**
+ * @var hyacinth_event pStagedMotion
+ * @brief The merged motion event waiting to be published. It is published
+ * right before any other event, so ordering is preserved, or once the current
+ * batch of events is done.
+ * @since v0.0.0.55
+ *
+ * @remark As of v0.0.0.69, it stays staged across batches, merging all the
+ * while, until another event follows it or @ref hyacinth_nextEvent finds
+ * nothing older. Either way, this is only touched under @ref pDispatchLock
+ * while the reader thread runs.
+ */
+static hyacinth_event pStagedMotion = {0};
+
+/**
+ * @var bool pStaged
+ * @brief Whether or not @ref pStagedMotion holds an event.
+ * @since v0.0.0.55
+ */
+static bool pStaged = false;
+
+/**
+ * @var hyacinth_event pStagedRelative
+ * @brief The relative motion waiting to be published, summed over every event
+ * merged into it. This is staged apart from @ref pStagedMotion, so that
+ * neither kind of motion forces the other out.
+ * @since v0.0.0.69
+ */
+static hyacinth_event pStagedRelative = {0};
+
+/**
+ * @var bool pRelativeStaged
+ * @brief Whether or not @ref pStagedRelative holds an event.
+ * @since v0.0.0.69
+ */
+static bool pRelativeStaged = false;
+
+/**
+ * @var struct wl_event_queue *pQueue
+ * @brief The private event queue of the reader thread. All of our objects are
+ * moved onto this while the reader runs, so that it never steals events from
+ * anyone else's queue (like that of an EGL implementation).
+ * @since v0.0.0.49
+ */
+static struct wl_event_queue *pQueue = nullptr;
+
+/**
+ * @var pthread_t pReader
+ * @brief The reader thread, if it is running.
+ * @since v0.0.0.49
+ */
+static pthread_t pReader;
+
+/**
+ * @var bool pThreaded
+ * @brief Whether or not the reader thread is running. This is only ever
+ * touched by the application's thread.
+ * @since v0.0.0.49
+ */
+static bool pThreaded = false;
+
+/**
+ * @var bool pBatching
+ * @brief Whether or not a batch of requests is being gathered, in which case
+ * presenting a frame does not send it.
+ * @since v0.0.0.67
+ *
+ * @remark As of v0.0.0.69, the reader thread doesn't flush during a batch
+ * either, so this is read from it too.
+ */
+static _Atomic bool pBatching = false;
+
+/**
+ * @var hyacinth_startup pStartup
+ * @brief How long each phase of creating the window took.
+ * @since v0.0.0.68
+ */
+static hyacinth_startup pStartup = {0};
+
+/**
+ * @var uint64_t pStartupMark
+ * @brief The time the current phase of creating the window began.
+ * @since v0.0.0.69
+ */
+static uint64_t pStartupMark = 0;
+
+/**
+ * @var struct wl_callback *pStartupCallback
+ * @brief The callback fired once the registry has announced every global,
+ * while the window is still being created.
+ * @since v0.0.0.69
+ */
+static struct wl_callback *pStartupCallback = nullptr;
+
+/**
+ * @var char *pTitle
+ * @brief The title of the window, kept until the window is built.
+ * @since v0.0.0.69
+ */
+static char *pTitle = nullptr;
+
+/**
+ * @var bool pConfigured
+ * @brief Whether or not the window has ever been configured.
+ * @since v0.0.0.69
+ */
+static bool pConfigured = false;
+
+/**
+ * @fn uint64_t lap(uint64_t *mark)
+ * @brief Measure the time since the last lap, and start the next one. The
+ * monotonic clock is used, since the presentation clock isn't known until
+ * the registry has been read.
+ * @since v0.0.0.68
+ *
+ * @param[in,out] mark The time the last lap ended, in nanoseconds.
+ * @return The time since then, in nanoseconds.
+ */
+static uint64_t lap(uint64_t *mark)
+{
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t time = (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+    uint64_t lapped = time - *mark;
+    *mark = time;
+    return lapped;
+}
+
+/**
+ * @fn void shorten(struct timespec *left, uint64_t *mark)
+ * @brief Take the time since a mark out of what's left of a timeout, for waits
+ * that poll more than once, so that they don't start over each time.
+ * @since v0.0.0.69
+ *
+ * @param[in,out] left What's left of the timeout, which stops at zero.
+ * @param[in,out] mark The mark, as for @ref lap.
+ */
+static void shorten(struct timespec *left, uint64_t *mark)
+{
+    uint64_t spent = lap(mark);
+    uint64_t total =
+        (uint64_t)left->tv_sec * 1000000000 + (uint64_t)left->tv_nsec;
+    total = spent < total ? total - spent : 0;
+    left->tv_sec = (time_t)(total / 1000000000);
+    left->tv_nsec = (long)(total % 1000000000);
+}
+
+/**
+ * @var int pStopFD
+ * @brief An @c eventfd the application's thread writes to in order to wake the
+ * reader thread and tell it to stop.
+ * @since v0.0.0.49
+ */
+static int pStopFD = -1;
+
+/**
+ * @var int pNotifyFD
+ * @brief An @c eventfd the reader thread writes to once per batch of events it
+ * delivers, waking anyone waiting on the application's side.
+ * @since v0.0.0.49
+ */
+static int pNotifyFD = -1;
+
+/**
+ * @var bool pReleased
+ * @brief Whether the compositor has released a buffer since the reader thread
+ * last woke the application's. A release pushes no event, but someone may be
+ * waiting on @ref pNotifyFD for a buffer to come free all the same.
+ * @since v0.0.0.69
+ */
+static _Atomic bool pReleased = false;
+
+/**
+ * @var pthread_mutex_t pDispatchLock
+ * @brief Held by the reader thread while dispatching, and by the application's
+ * thread while creating objects that receive events. This ensures no event
+ * can be dispatched to an object before its listener is attached. It is never
+ * held by anyone in the common path of reading events.
+ * @since v0.0.0.49
+ *
+ * @remark As of v0.0.0.69, this also guards @ref pStagedMotion, which the
+ * application's thread takes once it runs out of other events.
+ */
+static pthread_mutex_t pDispatchLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @fn void ringPush(struct event_ring *ring, const hyacinth_event *event)
+ * @brief Publish an event to a ring. If the ring is full, the event is
+ * dropped; blocking the producer would stall the whole connection.
+ * @since v0.0.0.55
+ *
+ * @param[in] ring The ring to publish to.
+ * @param[in] event The event to publish.
+ */
+static void ringPush(struct event_ring *ring, const hyacinth_event *event)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - ring->tailCache == EVENT_RING)
+    {
+        ring->tailCache =
+            atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (__builtin_expect(head - ring->tailCache == EVENT_RING, false))
+        {
+            if (!ring->overflowed)
+                primrose_log(WARNING, "Event ring full, dropping events.");
+            ring->overflowed = true;
+            return;
+        }
+    }
+
+    ring->overflowed = false;
+    ring->events[head & (EVENT_RING - 1)] = *event;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/**
+ * @fn bool ringPop(struct event_ring *ring, hyacinth_event *event)
+ * @brief Take the oldest event out of a ring.
+ * @since v0.0.0.55
+ *
+ * @param[in] ring The ring to take from.
+ * @param[out] event The storage for the event.
+ * @return Whether or not an event was available.
+ */
+static bool ringPop(struct event_ring *ring, hyacinth_event *event)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (tail == ring->headCache)
+    {
+        ring->headCache =
+            atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail == ring->headCache) return false;
+    }
+
+    *event = ring->events[tail & (EVENT_RING - 1)];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @fn void flushMotion(void)
+ * @brief Publish the merged motion event, if there is one.
+ * @since v0.0.0.55
+ *
+ * @remark As of v0.0.0.69, this publishes merged relative motion as well.
+ */
+static void flushMotion(void)
+{
+    if (pStaged) ringPush(&pEvents, &pStagedMotion);
+    if (pRelativeStaged) ringPush(&pEvents, &pStagedRelative);
+    pStaged = pRelativeStaged = false;
+}
+
+/**
+ * @fn void pushEvent(const hyacinth_event *event)
+ * @brief Publish an event to the event ring, after any merged motion event
+ * that precedes it.
+ * @since v0.0.0.49
+ *
+ * @param[in] event The event to publish.
+ */
+static void pushEvent(const hyacinth_event *event)
+{
+    flushMotion();
+    ringPush(&pEvents, event);
+}
+
+/**
+ * @copydoc xdg_wm_base_listener::ping
+ */
+static void ping(void *, struct xdg_wm_base *b, uint32_t s)
+{
+    // xdg_wm_base_pong
+    (void)wl_proxy_marshal_flags((struct wl_proxy *)b, 3, nullptr,
+                                 wl_proxy_get_version((struct wl_proxy *)b), 0,
+                                 s);
+}
+
+/**
+ * @struct xdg_wm_base_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from the XDG "registry" object,
+ * @c wm_base. This is basically a nerdy game of table tennis, we just recieve a
+ * ping and send back a pong, over and over again so the WM doesn't think we're
+ * a zombie.
+ * @since v0.0.0.20
+ */
+static struct xdg_wm_base_listener
+{
+    /**
+     * @property ping
+     * @brief The ping event asks the client if it’s still alive. Pass the
+     * serial specified in the event back to the compositor by sending a “pong”
+     * request back with the specified serial. A compositor is free to ping in
+     * any way it wants, but a client must always respond to any xdg_wm_base
+     * object it created.
+     * @since v0.0.0.20
+     *
+     * @remark It’s unspecified what will happen if the client doesn’t respond
+     * to the ping request, or in what timeframe.
+     *
+     * @param[in] data Any data to be sent alongside events.
+     * @param[in] base The window mananger base object that generated the event.
+     * @param[in] serial The serial code of the event. The client must respond
+     * to the ping with this serial code in its pong.
+     */
+    void (*ping)(void *data, struct xdg_wm_base *base, uint32_t serial);
+}
+/**
+ * @var struct xdg_wm_base_listener pShellListener
+ * @brief The listener for the XDG window manager base object, which is
+ * basically the "registry" for the XDG Shell protocol.
+ * @since v0.0.0.2
+ *
+ * @copydoc xdg_wm_base_listener
+ */
+pShellListener = {.ping = &ping};
+
+/**
+ * @fn void applyDestination(void)
+ * @brief Tell the compositor what size to show the window at, which takes
+ * effect on the next commit.
+ * @since v0.0.0.63
+ */
+static void applyDestination(void)
+{
+    if (pViewport == nullptr) return;
+
+    uint32_t width = pDestWidth, height = pDestHeight;
+    if (width == 0 || height == 0)
+    {
+        width = pLogicalWidth;
+        height = pLogicalHeight;
+    }
+    // (wp_viewport_set_destination)
+    (void)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pViewport, 2, nullptr,
+        wl_proxy_get_version((struct wl_proxy *)pViewport), 0,
+        width != 0 && height != 0 ? (int32_t)width : -1,
+        width != 0 && height != 0 ? (int32_t)height : -1);
+}
+
+/**
+ * @copydoc xdg_surface_listener::configure
+ */
+static void configure(void *, struct xdg_surface *, uint32_t s)
+{
+    // This is applied once the batch of events is done, so a storm of
+    // configurations costs one acknowledgement and one resize.
+    pPendingSerial = s;
+    pConfigurePending = true;
+}
+
+/**
+ * @struct xdg_surface_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events for the @c xdg_surface wrapper around
+ * the @c wl_surface object.
+ * @since v0.0.0.20
+ */
+static const struct xdg_surface_listener
+{
+    /**
+     * @property configure
+     * @brief The configure event marks the end of a configure sequence. A
+     * configure sequence is a set of one or more events configuring the state
+     * of the xdg_surface. Clients should send an ack_configure before
+     * committing the new surface.
+     * @since v0.0.0.20
+     *
+     * @remark Where applicable, xdg_surface surface roles will during a
+     * configure sequence extend this event as a latched state sent as events
+     * before the xdg_surface.configure event. If the client receives multiple
+     * configure events before it can respond to one, it is free to discard all
+     * but the last event it received.
+     *
+     * @param[in] data Any user-defined data sent alongside the surface.
+     * @param[in] surface The surface who is being configured.
+     * @param[in] serial The serial ID of this event. This should be sent
+     * alongside a configuration acknowledgement event.
+     */
+    void (*configure)(void *data, struct xdg_surface *surface, uint32_t serial);
+}
+/**
+ * @var struct xdg_surface_listener pShellSurfaceListener
+ * @brief The listener for the XDG surface object. This handles exclusvely
+ * surface-level configuration-end events sent by the server.
+ * @since v0.0.0.2
+ *
+ * @copydoc xdg_surface_listener
+ */
+pShellSurfaceListener = {&configure};
+
+/**
+ * @fn uint32_t currentScale(void)
+ * @brief Get the scale the window is drawn at, in 120ths. The fractional scale
+ * is only usable alongside a viewport, since buffer scales are integers.
+ * @since v0.0.0.62
+ *
+ * @return The scale.
+ */
+static inline uint32_t currentScale(void)
+{
+    uint32_t scale120 = pScale120;
+    if (scale120 != 0 && pViewport != nullptr) return scale120;
+    return (uint32_t)pScale * 120;
+}
+
+/**
+ * @fn void resize(void)
+ * @brief Recompute the size of the window in pixels from its size in screen
+ * coordinates and its scale, announcing any change.
+ * @since v0.0.0.62
+ */
+static void resize(void)
+{
+    // The protocol demands rounding halfway away from zero.
+    uint32_t scale = currentScale();
+    uint32_t width = (uint32_t)(((uint64_t)pLogicalWidth * scale + 60) / 120);
+    uint32_t height =
+        (uint32_t)(((uint64_t)pLogicalHeight * scale + 60) / 120);
+    if (width == pWidth && height == pHeight) return;
+
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_RESIZE,
+                                .resize = {width, height}});
+    pWidth = width;
+    pHeight = height;
+    pSizeGeneration++;
+    primrose_log(VERBOSE, "Window dimensions adjusted: %dx%d.", width, height);
+}
+
+/**
+ * @fn void applyConfigure(void)
+ * @brief Apply the latest configuration and scale, if either changed. This is
+ * called once each batch of events has been dispatched, by whichever thread
+ * dispatched it.
+ * @since v0.0.0.64
+ *
+ * @remark As of v0.0.0.69, the first configuration also completes creation.
+ *
+ * @remark As of v0.0.0.69, the configuration is only latched into @ref pAck
+ * here. Acknowledging it from the reader thread could slip in between
+ * acquiring a buffer of the old size and presenting it.
+ */
+static void applyConfigure(void)
+{
+    bool first = false, latch = false;
+    if (pConfigurePending)
+    {
+        pConfigurePending = false;
+        latch = true;
+        pLogicalWidth = pPendingWidth;
+        pLogicalHeight = pPendingHeight;
+        // The window is exactly as large as configured, whatever the buffer.
+        applyDestination();
+        pRescaled = true;
+
+        uint32_t changed = pStates ^ pPendingStates;
+        if (changed != 0)
+        {
+            pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                        .type = HYACINTH_EVENT_STATE,
+                                        .state = {pPendingStates, changed}});
+            pStates = pPendingStates;
+        }
+        first = !pConfigured;
+        pConfigured = true;
+        primrose_log(VERBOSE_OK, "Configure request completed.");
+    }
+    if (pRescaled)
+    {
+        pRescaled = false;
+        resize();
+    }
+    // Only after the resize, so whoever sees the serial sees the size too.
+    if (latch) pAck = (uint64_t)1 << 32 | pPendingSerial;
+    if (!first) return;
+
+    pStartup.configure = lap(&pStartupMark);
+    pStartup.total = pStartup.connect + pStartup.registry + pStartup.surface +
+                     pStartup.configure;
+    primrose_log(VERBOSE, "Window created in %lluus.",
+                 (unsigned long long)(pStartup.total / 1000));
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_CONFIGURED,
+                                .resize = {pWidth, pHeight}});
+}
+
+/**
+ * @fn void ackConfigure(uint64_t ack)
+ * @brief Acknowledge a configuration latched by @ref applyConfigure, unless
+ * it already has been. This is only ever called by the application's thread,
+ * before the commit that first carries the configured size.
+ * @since v0.0.0.69
+ *
+ * @param[in] ack The configuration, as a value of @ref pAck.
+ */
+static void ackConfigure(uint64_t ack)
+{
+    if (ack == 0 || ack == pAcked) return;
+
+    pAcked = ack;
+    // xdg_surface_ack_configure
+    (void)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pShellSurface, 4, nullptr,
+        wl_proxy_get_version((struct wl_proxy *)pShellSurface), 0,
+        (uint32_t)ack);
+}
+
+/**
+ * @fn void ackLatest(void)
+ * @brief Acknowledge the latest configuration from the application's thread.
+ * Software buffers are left to @ref hyacinth_present, which waits for the
+ * buffer made at the configured size; anyone drawing for themselves resizes
+ * upon seeing the event, well before their next commit.
+ * @since v0.0.0.69
+ */
+static void ackLatest(void)
+{
+    if (pShmPool == nullptr) ackConfigure(pAck);
+}
+
+/**
+ * @copydoc xdg_toplevel_listener::topConfigure
+ */
+static void topConfigure(void *, struct xdg_toplevel *, int32_t w, int32_t h,
+                         struct wl_array *s)
+{
+    primrose_log(VERBOSE_BEGIN, "Configure request recieved.");
+
+    pPendingWidth = (uint32_t)w;
+    pPendingHeight = (uint32_t)h;
+    pPendingStates = 0;
+
+    int32_t *i;
+    wl_array_for_each(i, s)
+    {
+        switch (*i)
+        {
+            case 2:
+                primrose_log(VERBOSE, "The window is now fullscreened.");
+                break;
+            case 4:
+                primrose_log(VERBOSE, "The window is now activated.");
+                break;
+            case 9: primrose_log(NOTE, "The window is now suspended."); break;
+            case 1:
+            case 3:
+            case 5:
+            case 6:
+            case 7:
+            case 8: break;
+            default:
+                primrose_log(WARNING, "Got unknown state value '%d'.", *i);
+                continue;
+        }
+        // The protocol's states count up from one, as do our bits.
+        pPendingStates |= 1u << (*i - 1);
+    }
+}
+
+/**
+ * @copydoc xdg_toplevel_listener::close
+ */
+static void requestClose(void *, struct xdg_toplevel *)
+{
+    primrose_log(NOTE, "Closing window.");
+    pClose = true;
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_CLOSE});
+}
+
+/**
+ * @copydoc xdg_toplevel_listener::bounds
+ */
+static void bounds(void *, struct xdg_toplevel *, int32_t, int32_t) {}
+
+/**
+ * @copydoc xdg_toplevel_listener::capabilities
+ */
+static void capabilities(void *, struct xdg_toplevel *, struct wl_array *c)
+{
+    int32_t *i;
+    wl_array_for_each(i, c) if (*i == 3)
+    {
+        primrose_log(VERBOSE_OK, "Found fullscreen support.");
+        return;
+    }
+
+    primrose_log(ERROR, "No fullscreen support available.");
+}
+
+/**
+ * @struct xdg_toplevel_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events for the @c xdg_toplevel structure.
+ * This provides a bunch of information about surface dimensions, capabilities,
+ * and more.
+ * @since v0.0.0.20
+ */
+static const struct xdg_toplevel_listener
+{
+    /**
+     * @property topConfigure
+     * @brief This configure event asks the client to resize its toplevel
+     * surface or to change its state. The width and height arguments specify a
+     * hint to the window about how its surface should be resized in window
+     * geometry coordinates. The states listed in the event specify how the
+     * width/height arguments should be interpreted, and possibly how it should
+     * be drawn.
+     * @since v0.0.0.20
+     *
+     * @remark If the width or height arguments are zero, it means the client
+     * should decide its own window dimension. This may happen when the
+     * compositor needs to configure the state of the surface but doesn’t have
+     * any information about any previous or expected dimension.
+     *
+     * @param[in] data Any data asked to have been sent alongside the toplevel.
+     * @param[in] toplevel The toplevel this configuration event was sent for.
+     * @param[in] width The suggested width of the window in screen coordinates.
+     * @param[in] height The suggested height of the window in screen
+     * coordinates.
+     * @param[in] states An array of states to use for dealing with the provided
+     * width and height or general window rendering.
+     */
+    void (*topConfigure)(void *data, struct xdg_toplevel *toplevel,
+                         int32_t width, int32_t height,
+                         struct wl_array *states);
+
+    /**
+     * @property close
+     * @brief The close event is sent by the compositor when the user wants the
+     * surface to be closed.
+     * @since v0.0.0.20
+     *
+     * @remark This is only a request that the user intends to close the window.
+     * The client may choose to ignore this request, or show a dialog to ask the
+     * user to save their data, etc.
+     *
+     * @param[in] data Any data asked to have been sent alongside the toplevel.
+     * @param[in] toplevel The toplevel that wishes to be closed.
+     */
+    void (*close)(void *data, struct xdg_toplevel *toplevel);
+
+    /**
+     * @property bounds
+     * @brief The configure_bounds event may be sent prior to a configure event
+     * to communicate the bounds a window geometry size is recommended to
+     * constrain to. The bounds can for example correspond to the size of a
+     * monitor excluding any panels or other shell components, so that a surface
+     * isn't created in a way that it cannot fit.
+     * @since v0.0.0.20
+     *
+     * @remarks If width and height are 0, it means bounds is unknown and
+     * equivalent to as if no configure_bounds event was ever sent for this
+     * surface.
+     *
+     * @param[in] data Any data asked to have been sent alongside the toplevel.
+     * @param[in] toplevel The toplevel this event was sent for.
+     * @param[in] width The constrain width in screen coordinates.
+     * @param[in] height The constrain height in screen coordinates.
+     */
+    void (*bounds)(void *data, struct xdg_toplevel *toplevel, int32_t width,
+                   int32_t height);
+
+    /**
+     * @property capabilities
+     * @brief This event advertises the capabilities supported by the
+     * compositor. If a capability isn't supported, clients should hide or
+     * disable the UI elements that expose this functionality. The
+     * compositor will ignore requests it doesn't support. Compositors must send
+     * this event once before the first xdg_surface.configure event. When the
+     * capabilities change, compositors must send this event again and then send
+     * a configure event.
+     * @since v0.0.0.20
+     *
+     * @remarks The capabilities are sent as an array of 32-bit unsigned
+     * integers in native endianness.
+     *
+     * @param[in] data Any data asked to have been sent alongside the toplevel.
+     * @param[in] toplevel The toplevel this event was sent for.
+     * @param[in] capabilities An array of the compositor's advertised
+     * capabilities.
+     */
+    void (*capabilities)(void *data, struct xdg_toplevel *toplevel,
+                         struct wl_array *capabilities);
+}
+/**
+ * @var struct xdg_toplevel_listener pToplevelListener
+ * @brief The listener for the XDG toplevel surface object. This handles
+ * configuration events and close requests.
+ * @since v0.0.0.2
+ *
+ * @copydoc xdg_toplevel_listener
+ */
+pToplevelListener = {&topConfigure, &requestClose, &bounds, &capabilities};
+
+/**
+ * @copydoc wl_callback_listener::done
+ */
+static void frameDone(void *, struct wl_callback *c, uint32_t t)
+{
+    wl_callback_destroy(c);
+    pFrameCallback = nullptr;
+    pFrameTime = t;
+    pFrameReady = true;
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_FRAME,
+                                .frame = {t}});
+}
+
+/**
+ * @var struct wl_callback_listener pFrameListener
+ * @brief The listener for frame callbacks, which simply notes down that it's
+ * time to draw and when that was decided.
+ * @since v0.0.0.47
+ */
+static const struct wl_callback_listener pFrameListener = {&frameDone};
+
+/**
+ * @copydoc wl_buffer_listener::release
+ */
+static void bufferRelease(void *d, struct wl_buffer *b)
+{
+    struct shm_buffer *buffer = d;
+    pReleased = true;
+    if (buffer->buffer == b)
+    {
+        buffer->busy = false;
+        // The swapchain has grown shallower since; see buildShm.
+        if ((size_t)(buffer - pShmBuffers) >= pShmDepth)
+        {
+            wl_buffer_destroy(b);
+            buffer->buffer = nullptr;
+            buffer->frame = 0;
+        }
+        return;
+    }
+
+    // The slot moved on to a new pool; this was only kept for the compositor.
+    for (size_t i = 0; i < SHM_ORPHANS; ++i)
+        if (pShmOrphans[i] == b) pShmOrphans[i] = nullptr;
+    wl_buffer_destroy(b);
+}
+
+/**
+ * @var struct wl_buffer_listener pBufferListener
+ * @brief The listener for shared memory buffers, which marks them as free to
+ * be drawn into once more, or destroys them if their pool has been replaced
+ * or their slot is past the depth of the swapchain.
+ * @since v0.0.0.50
+ *
+ * @remark As of v0.0.0.69, a release also raises @ref pReleased, so that an
+ * application blocked in @ref hyacinth_acquireBuffer behind the reader thread
+ * is woken even when the batch held nothing else.
+ */
+static const struct wl_buffer_listener pBufferListener = {&bufferRelease};
+
+/**
+ * @fn void pushPresentation(void *slot, hyacinth_presentation *report)
+ * @brief Retire a pending presentation slot and write its report into the
+ * ring, dropping the report if the application hasn't kept up.
+ * @since v0.0.0.48
+ *
+ * @param[in] slot The pending slot the report belongs to.
+ * @param[in] report The report, minus its submission time.
+ */
+static void pushPresentation(void *slot, hyacinth_presentation *report)
+{
+    struct presentation_slot *pending = slot;
+    wl_proxy_destroy((struct wl_proxy *)pending->feedback);
+    pending->feedback = nullptr;
+    report->submitted = pending->submitted;
+
+    uint64_t head = pPresentationHead;
+    if (head - pPresentationTail == PRESENTATION_RING) return;
+    pPresentations[head & (PRESENTATION_RING - 1)] = *report;
+    pPresentationHead = head + 1;
+}
+
+/**
+ * @copydoc wp_presentation_feedback_listener::syncOutput
+ */
+static void syncOutput(void *, struct wp_presentation_feedback *,
+                       struct wl_output *)
+{
+}
+
+/**
+ * @copydoc wp_presentation_feedback_listener::presented
+ */
+static void presented(void *d, struct wp_presentation_feedback *,
+                      uint32_t secHi, uint32_t secLo, uint32_t nsec,
+                      uint32_t refresh, uint32_t seqHi, uint32_t seqLo,
+                      uint32_t flags)
+{
+    uint64_t sec = ((uint64_t)secHi << 32) | secLo;
+    hyacinth_presentation report = {
+        .presented = sec * 1000000000 + nsec,
+        .sequence = ((uint64_t)seqHi << 32) | seqLo,
+        .refresh = refresh,
+        .flags = flags,
+    };
+    pLastPresented = report.presented;
+    pLastRefresh = refresh;
+    pushPresentation(d, &report);
+}
+
+/**
+ * @copydoc wp_presentation_feedback_listener::discarded
+ */
+static void discarded(void *d, struct wp_presentation_feedback *)
+{
+    pushPresentation(d, &(hyacinth_presentation){.discarded = true});
+}
+
+/**
+ * @struct wp_presentation_feedback_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling the events of a single frame's presentation
+ * feedback object. Exactly one of @ref presented or @ref discarded is sent,
+ * after which the object is dead.
+ * @since v0.0.0.48
+ */
+static const struct wp_presentation_feedback_listener
+{
+    /**
+     * @property syncOutput
+     * @brief As presentation can be synchronized to only one output at a time,
+     * this event tells which output it was. This event is only sent prior to
+     * the presented event.
+     * @since v0.0.0.48
+     *
+     * @param[in] data The pending presentation slot of the frame.
+     * @param[in] feedback The feedback object this event was sent for.
+     * @param[in] output The output the presentation was synchronized to.
+     */
+    void (*syncOutput)(void *data, struct wp_presentation_feedback *feedback,
+                       struct wl_output *output);
+
+    /**
+     * @property presented
+     * @brief The associated content update was displayed to the user at the
+     * indicated time.
+     * @since v0.0.0.48
+     *
+     * @param[in] data The pending presentation slot of the frame.
+     * @param[in] feedback The feedback object this event was sent for.
+     * @param[in] secHi The high 32 bits of the seconds of the timestamp.
+     * @param[in] secLo The low 32 bits of the seconds of the timestamp.
+     * @param[in] nsec The nanoseconds part of the timestamp.
+     * @param[in] refresh The nanoseconds until the next predicted refresh, or
+     * zero if unknown.
+     * @param[in] seqHi The high 32 bits of the vertical retrace counter.
+     * @param[in] seqLo The low 32 bits of the vertical retrace counter.
+     * @param[in] flags The kind of presentation that happened.
+     */
+    void (*presented)(void *data, struct wp_presentation_feedback *feedback,
+                      uint32_t secHi, uint32_t secLo, uint32_t nsec,
+                      uint32_t refresh, uint32_t seqHi, uint32_t seqLo,
+                      uint32_t flags);
+
+    /**
+     * @property discarded
+     * @brief The content update was never displayed to the user.
+     * @since v0.0.0.48
+     *
+     * @param[in] data The pending presentation slot of the frame.
+     * @param[in] feedback The feedback object this event was sent for.
+     */
+    void (*discarded)(void *data, struct wp_presentation_feedback *feedback);
+}
+/**
+ * @var struct wp_presentation_feedback_listener pFeedbackListener
+ * @brief The listener for every presentation feedback object we create.
+ * @since v0.0.0.48
+ *
+ * @copydoc wp_presentation_feedback_listener
+ */
+pFeedbackListener = {&syncOutput, &presented, &discarded};
+
+/**
+ * @copydoc wp_presentation_listener::clockID
+ */
+static void clockID(void *, struct wp_presentation *, uint32_t c)
+{
+    pPresentationClock = (clockid_t)c;
+    primrose_log(VERBOSE, "Presentation clock %u.", c);
+}
+
+/**
+ * @struct wp_presentation_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from the presentation timing
+ * object, of which there is only the one.
+ * @since v0.0.0.48
+ */
+static const struct wp_presentation_listener
+{
+    /**
+     * @property clockID
+     * @brief This event tells the client in which clock domain the compositor
+     * interprets the timestamps used by the presentation extension. This event
+     * is sent when the client binds to the interface.
+     * @since v0.0.0.48
+     *
+     * @param[in] data Any data sent alongside the presentation object.
+     * @param[in] presentation The presentation object that sent the event.
+     * @param[in] clock The POSIX clock ID, as in @c clock_gettime.
+     */
+    void (*clockID)(void *data, struct wp_presentation *presentation,
+                    uint32_t clock);
+}
+/**
+ * @var struct wp_presentation_listener pPresentationListener
+ * @brief The listener for the presentation timing object.
+ * @since v0.0.0.48
+ *
+ * @copydoc wp_presentation_listener
+ */
+pPresentationListener = {&clockID};
+
+/**
+ * @copydoc zwp_relative_pointer_v1_listener::relativeMotion
+ */
+static void relativeMotion(void *, struct zwp_relative_pointer_v1 *,
+                           uint32_t hi, uint32_t lo, wl_fixed_t dx,
+                           wl_fixed_t dy, wl_fixed_t rawX, wl_fixed_t rawY)
+{
+    hyacinth_event event = {.time = (((uint64_t)hi << 32) | lo) * 1000,
+                            .type = HYACINTH_EVENT_POINTER_RELATIVE,
+                            .relative = {dx, dy, rawX, rawY}};
+    if (!pCoalesce)
+    {
+        pushEvent(&event);
+        return;
+    }
+
+    // Deltas add up, and the absolute motion staged alongside stays put.
+    if (pKeepHistory) ringPush(&pMotionHistory, &event);
+    if (!pRelativeStaged) pStagedRelative = event;
+    else
+    {
+        pStagedRelative.time = event.time;
+        pStagedRelative.flags |= HYACINTH_FLAG_COALESCED;
+        pStagedRelative.relative.dx += dx;
+        pStagedRelative.relative.dy += dy;
+        pStagedRelative.relative.rawX += rawX;
+        pStagedRelative.relative.rawY += rawY;
+    }
+    pRelativeStaged = true;
+}
+
+/**
+ * @struct zwp_relative_pointer_v1_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from the relative pointer.
+ * @since v0.0.0.56
+ */
+static const struct zwp_relative_pointer_v1_listener
+{
+    /**
+     * @property relativeMotion
+     * @brief Relative motion of the pointer, sent alongside (but not within
+     * the frame of) any absolute motion, and even where there is none.
+     * @since v0.0.0.56
+     *
+     * @param[in] data Any data sent alongside the relative pointer.
+     * @param[in] pointer The relative pointer that sent the event.
+     * @param[in] utimeHi The high 32 bits of the microsecond timestamp.
+     * @param[in] utimeLo The low 32 bits of the microsecond timestamp.
+     * @param[in] dx The accelerated horizontal motion.
+     * @param[in] dy The accelerated vertical motion.
+     * @param[in] rawX The unaccelerated horizontal motion.
+     * @param[in] rawY The unaccelerated vertical motion.
+     */
+    void (*relativeMotion)(void *data, struct zwp_relative_pointer_v1 *pointer,
+                           uint32_t utimeHi, uint32_t utimeLo, wl_fixed_t dx,
+                           wl_fixed_t dy, wl_fixed_t rawX, wl_fixed_t rawY);
+}
+/**
+ * @var struct zwp_relative_pointer_v1_listener pRelativeListener
+ * @brief The listener for the relative pointer.
+ * @since v0.0.0.56
+ *
+ * @copydoc zwp_relative_pointer_v1_listener
+ */
+pRelativeListener = {&relativeMotion};
+
+/**
+ * @fn void constrained(void *, struct wl_proxy *)
+ * @brief The pointer lock or confinement was engaged.
+ * @since v0.0.0.56
+ */
+static void constrained(void *, struct wl_proxy *)
+{
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_POINTER_CONSTRAINT,
+                                .flags = HYACINTH_FLAG_ACTIVE});
+}
+
+/**
+ * @fn void unconstrained(void *, struct wl_proxy *)
+ * @brief The pointer lock or confinement was disengaged.
+ * @since v0.0.0.56
+ */
+static void unconstrained(void *, struct wl_proxy *)
+{
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_POINTER_CONSTRAINT});
+}
+
+/**
+ * @struct constraint_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from either a locked or a
+ * confined pointer, whose events are identical in all but name.
+ * @since v0.0.0.56
+ */
+static const struct constraint_listener
+{
+    /**
+     * @property constrained
+     * @brief The lock or confinement was engaged.
+     * @since v0.0.0.56
+     *
+     * @param[in] data Any data sent alongside the constraint.
+     * @param[in] constraint The constraint that sent the event.
+     */
+    void (*constrained)(void *data, struct wl_proxy *constraint);
+
+    /**
+     * @property unconstrained
+     * @brief The lock or confinement was disengaged. As it is persistent, the
+     * compositor may engage it again later.
+     * @since v0.0.0.56
+     *
+     * @param[in] data Any data sent alongside the constraint.
+     * @param[in] constraint The constraint that sent the event.
+     */
+    void (*unconstrained)(void *data, struct wl_proxy *constraint);
+}
+/**
+ * @var struct constraint_listener pConstraintListener
+ * @brief The listener for the pointer lock or confinement.
+ * @since v0.0.0.56
+ *
+ * @copydoc constraint_listener
+ */
+pConstraintListener = {&constrained, &unconstrained};
+
+/**
+ * @fn void timestamp(void *d, struct wl_proxy *, uint32_t hi, uint32_t lo,
+ * uint32_t nsec)
+ * @brief Store the precise timestamp of the device's upcoming input event.
+ * @since v0.0.0.57
+ */
+static void timestamp(void *d, struct wl_proxy *, uint32_t hi, uint32_t lo,
+                      uint32_t nsec)
+{
+    struct input_timestamps *stamps = d;
+    stamps->time = (((uint64_t)hi << 32) | lo) * 1000000000 + nsec;
+}
+
+/**
+ * @struct zwp_input_timestamps_v1_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from an input timestamps
+ * object.
+ * @since v0.0.0.57
+ */
+static const struct zwp_input_timestamps_v1_listener
+{
+    /**
+     * @property timestamp
+     * @brief The timestamp of the input event sent right after this one by
+     * the associated device, on the same clock as its millisecond timestamp.
+     * @since v0.0.0.57
+     *
+     * @param[in] data The timestamps of the device.
+     * @param[in] timestamps The timestamps object that sent the event.
+     * @param[in] secHi The high 32 bits of the seconds of the timestamp.
+     * @param[in] secLo The low 32 bits of the seconds of the timestamp.
+     * @param[in] nsec The nanoseconds part of the timestamp.
+     */
+    void (*timestamp)(void *data, struct wl_proxy *timestamps, uint32_t secHi,
+                      uint32_t secLo, uint32_t nsec);
+}
+/**
+ * @var struct zwp_input_timestamps_v1_listener pTimestampsListener
+ * @brief The listener for every input timestamps object.
+ * @since v0.0.0.57
+ *
+ * @copydoc zwp_input_timestamps_v1_listener
+ */
+pTimestampsListener = {&timestamp};
+
+/**
+ * @copydoc wp_fractional_scale_v1_listener::preferredScale
+ */
+static void preferredScale(void *, struct wp_fractional_scale_v1 *,
+                           uint32_t scale)
+{
+    pScale120 = scale;
+    pRescaled = true;
+    primrose_log(VERBOSE, "Preferred scale %u/120.", scale);
+}
+
+/**
+ * @struct wp_fractional_scale_v1_listener Wayland.c "Source/Wayland.c"
+ * @brief An interface for handling events sent from the fractional scale
+ * object of our surface.
+ * @since v0.0.0.62
+ */
+static const struct wp_fractional_scale_v1_listener
+{
+    /**
+     * @property preferredScale
+     * @brief The scale the compositor would like the surface drawn at. This
+     * is sent whenever it changes, for example by moving the window to
+     * another output.
+     * @since v0.0.0.62
+     *
+     * @param[in] data Any data sent alongside the fractional scale object.
+     * @param[in] scale The fractional scale object that sent the event.
+     * @param[in] scale120 The scale, in 120ths.
+     */
+    void (*preferredScale)(void *data, struct wp_fractional_scale_v1 *scale,
+                           uint32_t scale120);
+}
+/**
+ * @var struct wp_fractional_scale_v1_listener pFractionalScaleListener
+ * @brief The listener for the fractional scale object.
+ * @since v0.0.0.62
+ *
+ * @copydoc wp_fractional_scale_v1_listener
+ */
+pFractionalScaleListener = {&preferredScale};
+
+/**
+ * @fn uint64_t inputTime(struct input_timestamps *stamps, uint32_t time)
+ * @brief Get the timestamp of an input event in nanoseconds. This is the
+ * precise timestamp that preceded it if there was one, and otherwise its
+ * millisecond timestamp. Compositors take both from the monotonic clock, and
+ * so from the presentation clock, so they share a clock with @ref
+ * hyacinth_getTime in practice.
+ * @since v0.0.0.54
+ *
+ * @param[in,out] stamps The precise timestamps of the device, whose pending
+ * timestamp is consumed.
+ * @param[in] time The timestamp in milliseconds.
+ * @return The timestamp in nanoseconds.
+ */
+static inline uint64_t inputTime(struct input_timestamps *stamps,
+                                 uint32_t time)
+{
+    uint64_t precise = stamps->time;
+    stamps->time = 0;
+    return precise != 0 ? precise : (uint64_t)time * 1000000;
+}
+
+/**
+ * @fn void endPointerFrame(void)
+ * @brief Publish the pointer event assembled from the current frame, if the
+ * frame held anything. Pure motion is merged into the staged motion event
+ * instead, if coalescing is enabled.
+ * @since v0.0.0.55
+ */
+static void endPointerFrame(void)
+{
+    hyacinth_event *frame = &pPointerFrame;
+    if (frame->flags == 0) return;
+
+    if (frame->flags == HYACINTH_FLAG_MOTION && pCoalesce)
+    {
+        if (pKeepHistory) ringPush(&pMotionHistory, frame);
+        if (pStaged) pStagedMotion.flags |= HYACINTH_FLAG_COALESCED;
+        else pStagedMotion = *frame;
+        pStagedMotion.time = frame->time;
+        pStagedMotion.pointer = frame->pointer;
+        pStaged = true;
+    }
+    else pushEvent(frame);
+
+    frame->flags = 0;
+    frame->pointer.scrollX = frame->pointer.scrollY = 0;
+    frame->pointer.button = 0;
+}
+
+/**
+ * @fn void endLegacyFrame(struct wl_pointer *pointer)
+ * @brief Pointers older than version five never send frames, so each of their
+ * events is a frame of its own.
+ * @since v0.0.0.55
+ *
+ * @param[in] pointer The pointer that sent the event.
+ */
+static inline void endLegacyFrame(struct wl_pointer *pointer)
+{
+    if (wl_pointer_get_version(pointer) < 5) endPointerFrame();
+}
+
+/**
+ * @copydoc wl_pointer_listener::enter
+ */
+static void pointerEnter(void *, struct wl_pointer *, uint32_t,
+                         struct wl_surface *, wl_fixed_t x, wl_fixed_t y)
+{
+    pPointerFrame.pointer.x = x;
+    pPointerFrame.pointer.y = y;
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_POINTER_ENTER,
+                                .pointer = {x, y}});
+}
+
+/**
+ * @copydoc wl_pointer_listener::leave
+ */
+static void pointerLeave(void *, struct wl_pointer *, uint32_t,
+                         struct wl_surface *)
+{
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_POINTER_LEAVE});
+}
+
+/**
+ * @copydoc wl_pointer_listener::motion
+ */
+static void pointerMotion(void *, struct wl_pointer *p, uint32_t t,
+                          wl_fixed_t x, wl_fixed_t y)
+{
+    pPointerFrame.time = inputTime(&pPointerTimestamps, t);
+    pPointerFrame.flags |= HYACINTH_FLAG_MOTION;
+    pPointerFrame.pointer.x = x;
+    pPointerFrame.pointer.y = y;
+    endLegacyFrame(p);
+}
+
+/**
+ * @copydoc wl_pointer_listener::button
+ */
+static void pointerButton(void *, struct wl_pointer *p, uint32_t, uint32_t t,
+                          uint32_t b, uint32_t s)
+{
+    // Two buttons in one frame can't share an event.
+    if (pPointerFrame.flags & HYACINTH_FLAG_BUTTON) endPointerFrame();
+
+    pPointerFrame.time = inputTime(&pPointerTimestamps, t);
+    pPointerFrame.flags |= HYACINTH_FLAG_BUTTON;
+    if (s == WL_POINTER_BUTTON_STATE_PRESSED)
+        pPointerFrame.flags |= HYACINTH_FLAG_PRESSED;
+    pPointerFrame.pointer.button = b;
+    endLegacyFrame(p);
+}
+
+/**
+ * @copydoc wl_pointer_listener::axis
+ */
+static void pointerAxis(void *, struct wl_pointer *p, uint32_t t, uint32_t a,
+                        wl_fixed_t v)
+{
+    pPointerFrame.time = inputTime(&pPointerTimestamps, t);
+    pPointerFrame.flags |= HYACINTH_FLAG_AXIS;
+    if (a == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
+        pPointerFrame.pointer.scrollX += v;
+    else pPointerFrame.pointer.scrollY += v;
+    endLegacyFrame(p);
+}
+
+/**
+ * @copydoc wl_pointer_listener::frame
+ */
+static void pointerFrame(void *, struct wl_pointer *) { endPointerFrame(); }
+
+/**
+ * @copydoc wl_pointer_listener::axis_source
+ */
+static void pointerAxisSource(void *, struct wl_pointer *, uint32_t) {}
+
+/**
+ * @copydoc wl_pointer_listener::axis_stop
+ */
+static void pointerAxisStop(void *, struct wl_pointer *, uint32_t, uint32_t) {}
+
+/**
+ * @copydoc wl_pointer_listener::axis_discrete
+ */
+static void pointerAxisDiscrete(void *, struct wl_pointer *, uint32_t, int32_t)
+{
+}
+
+/**
+ * @var struct wl_pointer_listener pPointerListener
+ * @brief The listener for the pointer, which translates its events into ours.
+ * This covers version five of the interface, which is all we bind.
+ * @since v0.0.0.54
+ */
+static const struct wl_pointer_listener pPointerListener = {
+    .enter = &pointerEnter,
+    .leave = &pointerLeave,
+    .motion = &pointerMotion,
+    .button = &pointerButton,
+    .axis = &pointerAxis,
+    .frame = &pointerFrame,
+    .axis_source = &pointerAxisSource,
+    .axis_stop = &pointerAxisStop,
+    .axis_discrete = &pointerAxisDiscrete,
+};
+
+/**
+ * @fn uint64_t hashKeymap(uint64_t hash, const void *data, size_t size)
+ * @brief Hash keymap text via 64-bit FNV-1a. This only needs to tell keymaps
+ * apart, not resist anybody.
+ * @since v0.0.0.58
+ *
+ * @remark As of v0.0.0.69, a hash can be continued, so that several pieces of
+ * data may be hashed as one.
+ *
+ * @param[in] hash The hash so far, or the FNV offset basis to start afresh.
+ * @param[in] data The keymap text.
+ * @param[in] size The size of the text in bytes.
+ * @return The hash.
+ */
+static uint64_t hashKeymap(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+}
+
+/**
+ * @fn uint64_t xkbVersion(void)
+ * @brief Identify the keysym tables made by this build, from @ref KEYMAP_MAGIC
+ * and @ref KEYMAP_XKB. Every keymap hash starts from this.
+ * @since v0.0.0.69
+ *
+ * @return The hash of the build.
+ */
+static uint64_t xkbVersion(void)
+{
+    if (pXkbVersion != 0) return pXkbVersion;
+
+    static const char version[] = KEYMAP_XKB;
+    uint32_t magic = KEYMAP_MAGIC;
+    pXkbVersion = hashKeymap(0xCBF29CE484222325, &magic, sizeof(magic));
+    pXkbVersion = hashKeymap(pXkbVersion, version, sizeof(version) - 1);
+    return pXkbVersion;
+}
+
+/**
+ * @fn bool cachePath(char *path, uint64_t hash)
+ * @brief Get the path of the cached keysym table of a keymap, creating the
+ * cache directory along the way. That is @c $XDG_CACHE_HOME/hyacinth, or @c
+ * $HOME/.cache/hyacinth when the former is unset.
+ * @since v0.0.0.58
+ *
+ * @param[out] path Storage for the path, @c PATH_MAX bytes long.
+ * @param[in] hash The hash of the keymap.
+ * @return Whether or not there is a cache directory to use.
+ */
+static bool cachePath(char *path, uint64_t hash)
+{
+    const char *base = getenv("XDG_CACHE_HOME"), *suffix = "";
+    if (base == nullptr || base[0] != '/')
+    {
+        base = getenv("HOME");
+        suffix = "/.cache";
+        if (base == nullptr || base[0] != '/') return false;
+    }
+
+    int length = snprintf(path, PATH_MAX, "%s%s", base, suffix);
+    if (length < 0 || length >= PATH_MAX) return false;
+    (void)mkdir(path, 0700);
+
+    length = snprintf(path, PATH_MAX, "%s%s/hyacinth", base, suffix);
+    if (length < 0 || length >= PATH_MAX) return false;
+    if (mkdir(path, 0700) == -1 && errno != EEXIST) return false;
+
+    length = snprintf(path, PATH_MAX, "%s%s/hyacinth/keymap-%016llx", base,
+                      suffix, (unsigned long long)hash);
+    return length > 0 && length < PATH_MAX;
+}
+
+/**
+ * @fn bool loadKeymap(const char *path, uint64_t hash)
+ * @brief Map a cached keysym table into memory, read-only, if it exists and
+ * is sound.
+ * @since v0.0.0.58
+ *
+ * @param[in] path The path of the cached table.
+ * @param[in] hash The hash of the keymap it must be compiled from.
+ * @return Whether or not the table was loaded into @ref pKeymap.
+ */
+static bool loadKeymap(const char *path, uint64_t hash)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return false;
+
+    struct stat info;
+    void *table = MAP_FAILED;
+    if (fstat(fd, &info) == 0 &&
+        (size_t)info.st_size > sizeof(struct keymap_table))
+        table = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (table == MAP_FAILED) return false;
+
+    struct keymap_table *keymap = table;
+    size_t expected = sizeof(struct keymap_table) +
+                      keymap->layouts * sizeof(keymap->keysyms[0]);
+    if (keymap->magic != KEYMAP_MAGIC || keymap->hash != hash ||
+        keymap->layouts == 0 || keymap->layouts > 4 ||
+        (size_t)info.st_size != expected)
+    {
+        (void)munmap(table, info.st_size);
+        return false;
+    }
+
+    // The cache is pruned by age of last use, see pruneKeymaps.
+    (void)utimensat(AT_FDCWD, path, nullptr, 0);
+    pKeymap = keymap;
+    pKeymapSize = info.st_size;
+    pKeymapMapped = true;
+    return true;
+}
+
+/**
+ * @fn void storeKeymap(const char *path)
+ * @brief Write the keysym table out to the cache. The table is written to a
+ * temporary file first, so no other process ever sees half of it.
+ * @since v0.0.0.58
+ *
+ * @param[in] path The path of the cached table.
+ */
+static void storeKeymap(const char *path)
+{
+    char temporary[PATH_MAX];
+    int length = snprintf(temporary, PATH_MAX, "%s.%d", path, (int)getpid());
+    if (length < 0 || length >= PATH_MAX) return;
+
+    int fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1) return;
+
+    const uint8_t *data = (const uint8_t *)pKeymap;
+    size_t written = 0;
+    while (written < pKeymapSize)
+    {
+        ssize_t count = write(fd, data + written, pKeymapSize - written);
+        if (count == -1 && errno == EINTR) continue;
+        if (count <= 0) break;
+        written += count;
+    }
+    (void)close(fd);
+
+    if (written != pKeymapSize || rename(temporary, path) == -1)
+    {
+        primrose_log(WARNING, "Failed to cache keymap.");
+        (void)unlink(temporary);
+    }
+}
+
+/**
+ * @fn void pruneKeymaps(char *path)
+ * @brief Delete the least recently used keysym tables in the cache, until no
+ * more than @ref KEYMAP_CACHED remain. Every keymap ever seen would otherwise
+ * stay there forever.
+ * @since v0.0.0.69
+ *
+ * @param[in] path The path of any table within the cache. This is modified
+ * in the process, but restored.
+ */
+static void pruneKeymaps(char *path)
+{
+    char *name = strrchr(path, '/');
+    *name = '\0';
+    DIR *directory = opendir(path);
+    *name = '/';
+    if (directory == nullptr) return;
+
+    while (true)
+    {
+        char oldest[NAME_MAX + 1];
+        struct timespec oldestTime = {0};
+        size_t count = 0;
+
+        rewinddir(directory);
+        for (struct dirent *entry = readdir(directory); entry != nullptr;
+             entry = readdir(directory))
+        {
+            struct stat info;
+            if (strncmp(entry->d_name, "keymap-", 7) != 0 ||
+                fstatat(dirfd(directory), entry->d_name, &info,
+                        AT_SYMLINK_NOFOLLOW) == -1)
+                continue;
+
+            if (count++ == 0 || info.st_mtim.tv_sec < oldestTime.tv_sec ||
+                (info.st_mtim.tv_sec == oldestTime.tv_sec &&
+                 info.st_mtim.tv_nsec < oldestTime.tv_nsec))
+            {
+                oldestTime = info.st_mtim;
+                (void)strcpy(oldest, entry->d_name);
+            }
+        }
+        if (count <= KEYMAP_CACHED ||
+            unlinkat(dirfd(directory), oldest, 0) == -1)
+            break;
+    }
+    (void)closedir(directory);
+}
+
+/**
+ * @fn uint32_t modifierMask(struct xkb_keymap *keymap, const char *name)
+ * @brief Get the mask of a named modifier.
+ * @since v0.0.0.58
+ *
+ * @param[in] keymap The keymap.
+ * @param[in] name The name of the modifier.
+ * @return The mask, or zero if there is no such modifier.
+ */
+static uint32_t modifierMask(struct xkb_keymap *keymap, const char *name)
+{
+    xkb_mod_index_t index = xkb_keymap_mod_get_index(keymap, name);
+    return index == XKB_MOD_INVALID || index >= 32 ? 0 : 1u << index;
+}
+
+/**
+ * @fn bool compileKeymap(const char *text, size_t size, uint64_t hash)
+ * @brief Compile keymap text via xkbcommon and flatten it into a keysym table
+ * stored in @ref pKeymap. This is the slow path, taken once per keymap.
+ * @since v0.0.0.58
+ *
+ * @param[in] text The keymap text, which need not be terminated.
+ * @param[in] size The size of the text in bytes.
+ * @param[in] hash The hash of the text.
+ * @return Whether or not compilation succeeded.
+ */
+static bool compileKeymap(const char *text, size_t size, uint64_t hash)
+{
+    // The keymap is complete; there is nothing to include or look up.
+    struct xkb_context *context =
+        xkb_context_new(XKB_CONTEXT_NO_DEFAULT_INCLUDES |
+                        XKB_CONTEXT_NO_ENVIRONMENT_NAMES);
+    if (__builtin_expect(context == nullptr, false)) return false;
+
+    struct xkb_keymap *keymap = xkb_keymap_new_from_buffer(
+        context, text, size, XKB_KEYMAP_FORMAT_TEXT_V1,
+        XKB_KEYMAP_COMPILE_NO_FLAGS);
+    struct xkb_state *state = keymap != nullptr ? xkb_state_new(keymap)
+                                                : nullptr;
+    if (__builtin_expect(state == nullptr, false))
+    {
+        if (keymap != nullptr) xkb_keymap_unref(keymap);
+        xkb_context_unref(context);
+        return false;
+    }
+
+    uint32_t layouts = xkb_keymap_num_layouts(keymap);
+    if (layouts == 0) layouts = 1;
+    else if (layouts > 4) layouts = 4;
+
+    size_t tableSize = sizeof(struct keymap_table) +
+                       layouts * sizeof(pKeymap->keysyms[0]);
+    struct keymap_table *table = calloc(1, tableSize);
+    if (__builtin_expect(table != nullptr, true))
+    {
+        table->magic = KEYMAP_MAGIC;
+        table->layouts = layouts;
+        table->hash = hash;
+        table->shift = modifierMask(keymap, XKB_MOD_NAME_SHIFT);
+        table->lock = modifierMask(keymap, XKB_MOD_NAME_CAPS);
+        // Every stock layout puts the third level on Mod5.
+        table->level3 = modifierMask(keymap, "Mod5");
+        table->num = modifierMask(keymap, XKB_MOD_NAME_NUM);
+
+        for (uint32_t l = 0; l < layouts; ++l)
+            for (uint32_t m = 0; m < KEYMAP_LEVELS; ++m)
+            {
+                uint32_t held = (m & 1 ? table->shift : 0) |
+                                (m & 4 ? table->level3 : 0);
+                uint32_t locked = (m & 2 ? table->lock : 0) |
+                                  (m & 8 ? table->num : 0);
+                (void)xkb_state_update_mask(state, held, 0, locked, 0, 0, l);
+                for (uint32_t k = 8; k < KEYMAP_KEYS; ++k)
+                    table->keysyms[l][k][m] =
+                        xkb_state_key_get_one_sym(state, k);
+            }
+        for (uint32_t k = 8; k < KEYMAP_KEYS; ++k)
+            if (xkb_keymap_key_repeats(keymap, k))
+                table->repeats[k / 32] |= 1u << (k % 32);
+    }
+
+    xkb_state_unref(state);
+    xkb_keymap_unref(keymap);
+    xkb_context_unref(context);
+    if (__builtin_expect(table == nullptr, false)) return false;
+
+    pKeymap = table;
+    pKeymapSize = tableSize;
+    pKeymapMapped = false;
+    return true;
+}
+
+/**
+ * @fn void releaseKeymap(void)
+ * @brief Release the current keysym table, if there is one.
+ * @since v0.0.0.58
+ */
+static void releaseKeymap(void)
+{
+    if (pKeymap == nullptr) return;
+
+    if (pKeymapMapped) (void)munmap(pKeymap, pKeymapSize);
+    else free(pKeymap);
+    pKeymap = nullptr;
+    pKeymapSize = 0;
+}
+
+/**
+ * @fn uint32_t keysym(uint32_t key)
+ * @brief Resolve a key to its keysym, given the current modifiers and layout.
+ * @since v0.0.0.58
+ *
+ * @param[in] key The Linux input event code of the key.
+ * @return The keysym, or zero if there is none.
+ */
+static inline uint32_t keysym(uint32_t key)
+{
+    const struct keymap_table *table = pKeymap;
+    uint32_t code = key + 8;
+    if (__builtin_expect(table == nullptr || code >= KEYMAP_KEYS, false))
+        return 0;
+
+    uint32_t level = ((pModifiers & table->shift) != 0) |
+                     ((pModifiers & table->lock) != 0) << 1 |
+                     ((pModifiers & table->level3) != 0) << 2 |
+                     ((pModifiers & table->num) != 0) << 3;
+    return table->keysyms[pGroup % table->layouts][code][level];
+}
+
+/**
+ * @fn bool repeats(uint32_t key)
+ * @brief Check whether a key repeats when held. Modifiers, for one, do not.
+ * @since v0.0.0.59
+ *
+ * @param[in] key The Linux input event code of the key.
+ * @return Whether or not the key repeats.
+ */
+static inline bool repeats(uint32_t key)
+{
+    const struct keymap_table *table = pKeymap;
+    uint32_t code = key + 8;
+    // Without a keymap, there is no telling modifiers apart; repeat nothing.
+    return pRepeatRate > 0 && table != nullptr && code < KEYMAP_KEYS &&
+           (table->repeats[code / 32] & (1u << (code % 32))) != 0;
+}
+
+/**
+ * @fn void armRepeat(uint32_t key)
+ * @brief Start repeating a key after the repeat delay, or stop repeating
+ * altogether.
+ * @since v0.0.0.59
+ *
+ * @param[in] key The key to repeat, which must repeat as per @ref repeats, or
+ * zero to stop.
+ */
+static void armRepeat(uint32_t key)
+{
+    if (key == 0 && pRepeatKey == 0) return;
+
+    uint64_t interval = key != 0 ? 1000000000 / pRepeatRate : 0;
+    uint64_t delay = (uint64_t)pRepeatDelay * 1000000;
+    struct itimerspec timer = {0};
+    if (key != 0)
+    {
+        // A zero value would disarm the timer instead.
+        if (delay == 0) delay = 1;
+        timer.it_value.tv_sec = delay / 1000000000;
+        timer.it_value.tv_nsec = delay % 1000000000;
+        timer.it_interval.tv_sec = interval / 1000000000;
+        timer.it_interval.tv_nsec = interval % 1000000000;
+    }
+
+    pRepeatKey = key;
+    pRepeatNext = hyacinth_getTime() + delay;
+    (void)timerfd_settime(pRepeatFD, 0, &timer, nullptr);
+}
+
+/**
+ * @fn void repeatKeys(void)
+ * @brief Send a key event for every repeat that has come due. Repeats are
+ * timestamped with when they were due rather than when we got around to them,
+ * and if far too many have come due (because the process was stopped, say),
+ * only the most recent are sent.
+ * @since v0.0.0.59
+ */
+static void repeatKeys(void)
+{
+    uint64_t count;
+    if (read(pRepeatFD, &count, sizeof(count)) != sizeof(count)) return;
+    if (pRepeatKey == 0 || pRepeatRate <= 0) return;
+
+    uint64_t interval = 1000000000 / pRepeatRate;
+    if (count > 32)
+    {
+        pRepeatNext += (count - 32) * interval;
+        count = 32;
+    }
+
+    uint32_t sym = keysym(pRepeatKey);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        pushEvent(&(hyacinth_event){
+            .time = pRepeatNext,
+            .type = HYACINTH_EVENT_KEY,
+            .flags = HYACINTH_FLAG_PRESSED | HYACINTH_FLAG_REPEAT,
+            .key = {pRepeatKey, sym}});
+        pRepeatNext += interval;
+    }
+}
+
+/**
+ * @copydoc wl_keyboard_listener::keymap
+ */
+static void keyboardKeymap(void *, struct wl_keyboard *, uint32_t f, int32_t fd,
+                           uint32_t size)
+{
+    if (f != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 || size == 0)
+    {
+        (void)close(fd);
+        return;
+    }
+
+    // The keymap is read straight out of the compositor's pages; the same
+    // mapping is handed to xkbcommon if it comes to compiling.
+    void *text = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (__builtin_expect(text == MAP_FAILED, false))
+    {
+        primrose_log(WARNING, "Failed to map keymap.");
+        return;
+    }
+
+    // The text is terminated, and the terminator is not part of it.
+    size_t length = strnlen(text, size);
+    // The same text may compile differently under another xkbcommon.
+    uint64_t hash = hashKeymap(xkbVersion(), text, length);
+    // Compositors resend the keymap on every layout switch, mostly unchanged.
+    if (pKeymap != nullptr && pKeymap->hash == hash)
+    {
+        (void)munmap(text, size);
+        return;
+    }
+
+    releaseKeymap();
+    char path[PATH_MAX];
+    bool cache = cachePath(path, hash);
+    if (cache && loadKeymap(path, hash))
+        primrose_log(VERBOSE_OK, "Loaded cached keymap %016llx.",
+                     (unsigned long long)hash);
+    else if (compileKeymap(text, length, hash))
+    {
+        if (cache)
+        {
+            storeKeymap(path);
+            pruneKeymaps(path);
+        }
+        primrose_log(VERBOSE_OK, "Compiled keymap %016llx.",
+                     (unsigned long long)hash);
+    }
+    else primrose_log(WARNING, "Failed to compile keymap.");
+    (void)munmap(text, size);
+}
+
+/**
+ * @copydoc wl_keyboard_listener::enter
+ */
+static void keyboardEnter(void *, struct wl_keyboard *, uint32_t,
+                          struct wl_surface *, struct wl_array *)
+{
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_KEYBOARD_ENTER});
+}
+
+/**
+ * @copydoc wl_keyboard_listener::leave
+ */
+static void keyboardLeave(void *, struct wl_keyboard *, uint32_t,
+                          struct wl_surface *)
+{
+    armRepeat(0);
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_KEYBOARD_LEAVE});
+}
+
+/**
+ * @copydoc wl_keyboard_listener::key
+ */
+static void keyboardKey(void *, struct wl_keyboard *, uint32_t, uint32_t t,
+                        uint32_t k, uint32_t s)
+{
+    // Pressing another repeating key takes over the repeat; pressing a
+    // modifier or releasing any other key does nothing to it.
+    if (s == WL_KEYBOARD_KEY_STATE_PRESSED)
+    {
+        if (repeats(k)) armRepeat(k);
+    }
+    else if (k == pRepeatKey) armRepeat(0);
+
+    pushEvent(&(hyacinth_event){
+        .time = inputTime(&pKeyboardTimestamps, t),
+        .type = HYACINTH_EVENT_KEY,
+        .flags = s == WL_KEYBOARD_KEY_STATE_PRESSED ? HYACINTH_FLAG_PRESSED : 0,
+        .key = {k, keysym(k)}});
+}
+
+/**
+ * @copydoc wl_keyboard_listener::modifiers
+ */
+static void keyboardModifiers(void *, struct wl_keyboard *, uint32_t,
+                              uint32_t d, uint32_t la, uint32_t lo, uint32_t g)
+{
+    pModifiers = d | la | lo;
+    pGroup = g;
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_MODIFIERS,
+                                .modifiers = {d, la, lo, g}});
+}
+
+/**
+ * @copydoc wl_keyboard_listener::repeat_info
+ */
+static void keyboardRepeat(void *, struct wl_keyboard *, int32_t r, int32_t d)
+{
+    pRepeatRate = r;
+    pRepeatDelay = d;
+    armRepeat(0);
+}
+
+/**
+ * @var struct wl_keyboard_listener pKeyboardListener
+ * @brief The listener for the keyboard, which translates its events into ours.
+ * @since v0.0.0.54
+ */
+static const struct wl_keyboard_listener pKeyboardListener = {
+    .keymap = &keyboardKeymap,
+    .enter = &keyboardEnter,
+    .leave = &keyboardLeave,
+    .key = &keyboardKey,
+    .modifiers = &keyboardModifiers,
+    .repeat_info = &keyboardRepeat,
+};
+
+/**
+ * @copydoc wl_touch_listener::down
+ */
+static void touchDown(void *, struct wl_touch *, uint32_t, uint32_t t,
+                      struct wl_surface *, int32_t i, wl_fixed_t x,
+                      wl_fixed_t y)
+{
+    pushEvent(&(hyacinth_event){.time = inputTime(&pTouchTimestamps, t),
+                                .type = HYACINTH_EVENT_TOUCH_DOWN,
+                                .touch = {i, x, y}});
+}
+
+/**
+ * @copydoc wl_touch_listener::up
+ */
+static void touchUp(void *, struct wl_touch *, uint32_t, uint32_t t, int32_t i)
+{
+    pushEvent(&(hyacinth_event){.time = inputTime(&pTouchTimestamps, t),
+                                .type = HYACINTH_EVENT_TOUCH_UP,
+                                .touch = {.id = i}});
+}
+
+/**
+ * @copydoc wl_touch_listener::motion
+ */
+static void touchMotion(void *, struct wl_touch *, uint32_t t, int32_t i,
+                        wl_fixed_t x, wl_fixed_t y)
+{
+    pushEvent(&(hyacinth_event){.time = inputTime(&pTouchTimestamps, t),
+                                .type = HYACINTH_EVENT_TOUCH_MOTION,
+                                .touch = {i, x, y}});
+}
+
+/**
+ * @copydoc wl_touch_listener::frame
+ */
+static void touchFrame(void *, struct wl_touch *) {}
+
+/**
+ * @copydoc wl_touch_listener::cancel
+ */
+static void touchCancel(void *, struct wl_touch *)
+{
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_TOUCH_CANCEL});
+}
+
+/**
+ * @var struct wl_touch_listener pTouchListener
+ * @brief The listener for the touchscreen, which translates its events into
+ * ours. This covers version five of the interface, which is all we bind.
+ * @since v0.0.0.54
+ */
+static const struct wl_touch_listener pTouchListener = {
+    .down = &touchDown,
+    .up = &touchUp,
+    .motion = &touchMotion,
+    .frame = &touchFrame,
+    .cancel = &touchCancel,
+};
+
+/**
+ * @fn void releaseDevice(void *device, uint32_t opcode)
+ * @brief Let go of an input device. Devices of version three and up have a
+ * proper release request; before that, the best we can do is forget them.
+ * @since v0.0.0.54
+ *
+ * @param[in] device The pointer, keyboard, or touchscreen object.
+ * @param[in] opcode The opcode of the release request of the device's
+ * interface.
+ */
+static void releaseDevice(void *device, uint32_t opcode)
+{
+    uint32_t version = wl_proxy_get_version(device);
+    if (version >= WL_POINTER_RELEASE_SINCE_VERSION)
+        (void)wl_proxy_marshal_flags(device, opcode, nullptr, version,
+                                     WL_MARSHAL_FLAG_DESTROY);
+    else wl_proxy_destroy(device);
+}
+
+/**
+ * @fn void destroyProxy(struct wl_proxy **proxy)
+ * @brief Send the destructor request of an object, assuming it has opcode
+ * zero, as it does for all the extension objects we use, and forget it.
+ * @since v0.0.0.56
+ *
+ * @param[in,out] proxy The object, which may be @c nullptr.
+ */
+static void destroyProxy(struct wl_proxy **proxy)
+{
+    if (*proxy == nullptr) return;
+
+    (void)wl_proxy_marshal_flags(*proxy, 0, nullptr,
+                                 wl_proxy_get_version(*proxy),
+                                 WL_MARSHAL_FLAG_DESTROY);
+    *proxy = nullptr;
+}
+
+/**
+ * @fn void getRelativePointer(void)
+ * @brief Get the relative pointer of the seat's pointer, once both it and the
+ * relative pointer manager exist; they may arrive in either order.
+ * @since v0.0.0.56
+ *
+ * @remark As of v0.0.0.69, the relative pointer is only kept while it is
+ * wanted, see @ref pWantRelative, and is destroyed here once it isn't. The
+ * caller must hold @ref pDispatchLock.
+ */
+static void getRelativePointer(void)
+{
+    bool wanted = pWantRelative || (pConstraint != nullptr && pLocked);
+    if (!wanted && pRelativePointer != nullptr)
+        destroyProxy((struct wl_proxy **)&pRelativePointer);
+    if (!wanted || pRelativeManager == nullptr || pPointer == nullptr ||
+        pRelativePointer != nullptr)
+        return;
+
+    // zwp_relative_pointer_manager_v1_get_relative_pointer
+    pRelativePointer =
+        (struct zwp_relative_pointer_v1 *)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pRelativeManager, 1, &pRelativePointerInterface,
+            wl_proxy_get_version((struct wl_proxy *)pRelativeManager), 0,
+            nullptr, pPointer);
+    if (__builtin_expect(pRelativePointer == nullptr, false)) return;
+    // zwp_relative_pointer_v1_add_listener
+    (void)wl_proxy_add_listener((struct wl_proxy *)pRelativePointer,
+                                (void (**)(void))&pRelativeListener, nullptr);
+}
+
+/**
+ * @fn void getTimestamps(struct input_timestamps *stamps, uint32_t opcode,
+ * void *device)
+ * @brief Subscribe to the precise timestamps of an input device, once both it
+ * and the input timestamps manager exist; they may arrive in either order.
+ * @since v0.0.0.57
+ *
+ * @param[in,out] stamps The timestamps of the device.
+ * @param[in] opcode The opcode of the manager's request for the device kind.
+ * @param[in] device The device, which may be @c nullptr.
+ */
+static void getTimestamps(struct input_timestamps *stamps, uint32_t opcode,
+                          void *device)
+{
+    if (pTimestampsManager == nullptr || device == nullptr ||
+        stamps->proxy != nullptr)
+        return;
+
+    // zwp_input_timestamps_manager_v1_get_keyboard_timestamps,
+    // zwp_input_timestamps_manager_v1_get_pointer_timestamps,
+    // zwp_input_timestamps_manager_v1_get_touch_timestamps
+    stamps->time = 0;
+    stamps->proxy = wl_proxy_marshal_flags(
+        (struct wl_proxy *)pTimestampsManager, opcode,
+        &pInputTimestampsInterface,
+        wl_proxy_get_version((struct wl_proxy *)pTimestampsManager), 0, nullptr,
+        device);
+    if (__builtin_expect(stamps->proxy == nullptr, false)) return;
+    // zwp_input_timestamps_v1_add_listener
+    (void)wl_proxy_add_listener(stamps->proxy,
+                                (void (**)(void))&pTimestampsListener, stamps);
+}
+
+/**
+ * @fn void getAllTimestamps(void)
+ * @brief Subscribe to the precise timestamps of every input device we have.
+ * @since v0.0.0.57
+ */
+static void getAllTimestamps(void)
+{
+    getTimestamps(&pKeyboardTimestamps, 1, pKeyboard);
+    getTimestamps(&pPointerTimestamps, 2, pPointer);
+    getTimestamps(&pTouchTimestamps, 3, pTouch);
+}
+
+/**
+ * @copydoc wl_seat_listener::capabilities
+ */
+static void seatCapabilities(void *, struct wl_seat *s, uint32_t c)
+{
+    bool pointer = c & WL_SEAT_CAPABILITY_POINTER;
+    if (pointer && pPointer == nullptr)
+    {
+        pPointer = wl_seat_get_pointer(s);
+        (void)wl_pointer_add_listener(pPointer, &pPointerListener, nullptr);
+        getRelativePointer();
+        primrose_log(VERBOSE_OK, "Connected to pointer.");
+    }
+    else if (!pointer && pPointer != nullptr)
+    {
+        destroyProxy(&pConstraint);
+        destroyProxy((struct wl_proxy **)&pRelativePointer);
+        destroyProxy(&pPointerTimestamps.proxy);
+        // wl_pointer_release
+        releaseDevice(pPointer, 1);
+        pPointer = nullptr;
+    }
+
+    bool keyboard = c & WL_SEAT_CAPABILITY_KEYBOARD;
+    if (keyboard && pKeyboard == nullptr)
+    {
+        pKeyboard = wl_seat_get_keyboard(s);
+        (void)wl_keyboard_add_listener(pKeyboard, &pKeyboardListener, nullptr);
+        primrose_log(VERBOSE_OK, "Connected to keyboard.");
+    }
+    else if (!keyboard && pKeyboard != nullptr)
+    {
+        destroyProxy(&pKeyboardTimestamps.proxy);
+        // wl_keyboard_release
+        releaseDevice(pKeyboard, 0);
+        pKeyboard = nullptr;
+    }
+
+    bool touch = c & WL_SEAT_CAPABILITY_TOUCH;
+    if (touch && pTouch == nullptr)
+    {
+        pTouch = wl_seat_get_touch(s);
+        (void)wl_touch_add_listener(pTouch, &pTouchListener, nullptr);
+        primrose_log(VERBOSE_OK, "Connected to touchscreen.");
+    }
+    else if (!touch && pTouch != nullptr)
+    {
+        destroyProxy(&pTouchTimestamps.proxy);
+        // wl_touch_release
+        releaseDevice(pTouch, 0);
+        pTouch = nullptr;
+    }
+
+    getAllTimestamps();
+}
+
+/**
+ * @copydoc wl_seat_listener::name
+ */
+static void seatName(void *, struct wl_seat *, const char *) {}
+
+/**
+ * @var struct wl_seat_listener pSeatListener
+ * @brief The listener for the seat, which connects to and disconnects from its
+ * input devices as they come and go.
+ * @since v0.0.0.54
+ */
+static const struct wl_seat_listener pSeatListener = {&seatCapabilities,
+                                                      &seatName};
+
+/**
+ * @fn void updateScale(void)
+ * @brief Recompute @ref pScale from the outputs the window is on.
+ * @since v0.0.0.60
+ */
+static void updateScale(void)
+{
+    bool entered = false;
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+        entered |= pOutputs[i].proxy != nullptr && pOutputs[i].entered;
+
+    int32_t scale = 1;
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+        if (pOutputs[i].proxy != nullptr &&
+            (pOutputs[i].entered || !entered) &&
+            pOutputs[i].info.scale > scale)
+            scale = pOutputs[i].info.scale;
+    // The compositor knows better than our guess, where it says so.
+    if (pPreferredScale > 0) scale = pPreferredScale;
+
+    if (scale == pScale) return;
+
+    primrose_log(VERBOSE, "Monitor scale %d.", scale);
+    pScale = scale;
+    pRescaled = true;
+}
+
+/**
+ * @copydoc wl_output_listener::geometry
+ */
+static void geometry(void *d, struct wl_output *o, int32_t x, int32_t y,
+                     int32_t w, int32_t h, int32_t, const char *make,
+                     const char *model, int32_t t)
+{
+    struct output *output = d;
+    output->info.x = x;
+    output->info.y = y;
+    output->info.physicalWidth = w;
+    output->info.physicalHeight = h;
+    output->info.transform = (uint32_t)t;
+    // Newer outputs describe themselves properly.
+    if (wl_output_get_version(o) < 4)
+        (void)snprintf(output->info.description,
+                       sizeof(output->info.description), "%s %s", make, model);
+}
+
+/**
+ * @copydoc wl_output_listener::mode
+ */
+static void mode(void *d, struct wl_output *, uint32_t f, int32_t w, int32_t h,
+                 int32_t r)
+{
+    // Older compositors list every mode; only the current one matters.
+    if ((f & WL_OUTPUT_MODE_CURRENT) == 0) return;
+
+    struct output *output = d;
+    output->info.width = w;
+    output->info.height = h;
+    output->info.refresh = r;
+    primrose_log(VERBOSE, "Output mode %dx%d@%d.%03dHz.", w, h, r / 1000,
+                 r % 1000);
+}
+
+/**
+ * @copydoc wl_output_listener::finish
+ */
+static void finish(void *d, struct wl_output *)
+{
+    struct output *output = d;
+    updateScale();
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_OUTPUT_CHANGED,
+                                .output = {output->info.id}});
+}
+
+/**
+ * @copydoc wl_output_listener::scale
+ */
+static void scale(void *d, struct wl_output *, int32_t s)
+{
+    struct output *output = d;
+    output->info.scale = s;
+}
+
+/**
+ * @copydoc wl_output_listener::name
+ */
+static void name(void *d, struct wl_output *, const char *n)
+{
+    struct output *output = d;
+    (void)snprintf(output->info.name, sizeof(output->info.name), "%s", n);
+}
+
+/**
+ * @copydoc wl_output_listener::description
+ */
+static void description(void *d, struct wl_output *, const char *c)
+{
+    struct output *output = d;
+    (void)snprintf(output->info.description, sizeof(output->info.description),
+                   "%s", c);
+}
+
+/**
+ * @var struct wl_output_listener pOutputListener
+ * @brief The listener for the Wayland output object. This is nearly always a
+ * monitor, but is @b always a graphical output device of some kind. We don't
+ * care what it is; we're gonna send all our data to it anyway!
+ * @since v0.0.0.2
+ */
+static const struct wl_output_listener pOutputListener = {
+    &geometry, &mode, &finish, &scale, &name, &description};
+
+/**
+ * @fn struct output *findOutput(struct wl_output *proxy)
+ * @brief Find the table entry of an output object.
+ * @since v0.0.0.60
+ *
+ * @param[in] proxy The output object.
+ * @return The entry, or @c nullptr if the output is not ours.
+ */
+static struct output *findOutput(struct wl_output *proxy)
+{
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+        if (proxy != nullptr && pOutputs[i].proxy == proxy)
+            return &pOutputs[i];
+    return nullptr;
+}
+
+/**
+ * @copydoc wl_surface_listener::enter
+ */
+static void surfaceEnter(void *, struct wl_surface *, struct wl_output *o)
+{
+    struct output *output = findOutput(o);
+    if (output == nullptr) return;
+
+    output->entered = true;
+    output->order = ++pOutputEntries;
+    updateScale();
+}
+
+/**
+ * @copydoc wl_surface_listener::leave
+ */
+static void surfaceLeave(void *, struct wl_surface *, struct wl_output *o)
+{
+    struct output *output = findOutput(o);
+    if (output == nullptr) return;
+
+    output->entered = false;
+    updateScale();
+}
+
+/**
+ * @copydoc wl_surface_listener::preferred_buffer_scale
+ */
+static void preferredBufferScale(void *, struct wl_surface *, int32_t s)
+{
+    pPreferredScale = s;
+    updateScale();
+}
+
+/**
+ * @copydoc wl_surface_listener::preferred_buffer_transform
+ */
+static void preferredBufferTransform(void *, struct wl_surface *, uint32_t) {}
+
+/**
+ * @var struct wl_surface_listener pSurfaceListener
+ * @brief The listener for the window's surface, which tracks the outputs it
+ * is shown on.
+ * @since v0.0.0.60
+ *
+ * @remark As of v0.0.0.69, this also handles the version six events, since
+ * the compositor is bound at whatever version it offers.
+ */
+static const struct wl_surface_listener pSurfaceListener = {
+    .enter = &surfaceEnter,
+    .leave = &surfaceLeave,
+    .preferred_buffer_scale = &preferredBufferScale,
+    .preferred_buffer_transform = &preferredBufferTransform,
+};
+
+/**
+ * @fn void releaseOutput(struct output *output)
+ * @brief Release an output object and free its slot.
+ * @since v0.0.0.60
+ *
+ * @param[in] output The table entry of the output.
+ */
+static void releaseOutput(struct output *output)
+{
+    if (wl_output_get_version(output->proxy) >=
+        WL_OUTPUT_RELEASE_SINCE_VERSION)
+        wl_output_release(output->proxy);
+    else wl_output_destroy(output->proxy);
+    *output = (struct output){0};
+}
+
+/**
+ * @copydoc wl_registry_listener::global
+ */
+static void global(void *, struct wl_registry *registry, uint32_t name,
+                   const char *interface, uint32_t version)
+{
+    if (strcmp(interface, wl_compositor_interface.name) == 0)
+    {
+        pCompositor =
+            wl_registry_bind(registry, name, &wl_compositor_interface, version);
+        pFoundInterfaces++;
+        primrose_log(VERBOSE_OK, "Connected to compositor v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, "xdg_wm_base") == 0)
+    {
+        pShell = wl_registry_bind(registry, name, &pXDGShellInterface, version);
+        // xdg_wm_base_add_listener
+        (void)wl_proxy_add_listener((struct wl_proxy *)pShell,
+                                    (void (**)(void))&pShellListener, nullptr);
+        pFoundInterfaces++;
+        primrose_log(VERBOSE_OK, "Connected to window manager v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, wl_output_interface.name) == 0)
+    {
+        struct output *output = nullptr;
+        for (size_t i = 0; i < HYACINTH_OUTPUT_MAX && output == nullptr; ++i)
+            if (pOutputs[i].proxy == nullptr) output = &pOutputs[i];
+        if (output == nullptr)
+        {
+            primrose_log(WARNING, "Too many outputs, ignoring one.");
+            return;
+        }
+        // Only the first output ever counts towards the requirements.
+        if (output == pOutputs && pSurface == nullptr) pFoundInterfaces++;
+
+        output->info = (hyacinth_output){.id = name, .scale = 1};
+        output->proxy = wl_registry_bind(registry, name, &wl_output_interface,
+                                         version < 4 ? version : 4);
+        (void)wl_output_add_listener(output->proxy, &pOutputListener, output);
+        primrose_log(VERBOSE_OK, "Connected to output device v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, wl_seat_interface.name) == 0)
+    {
+        if (pSeat != nullptr) return;
+
+        pSeat = wl_registry_bind(registry, name, &wl_seat_interface,
+                                 version < 5 ? version : 5);
+        (void)wl_seat_add_listener(pSeat, &pSeatListener, nullptr);
+        primrose_log(VERBOSE_OK, "Connected to seat v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, wl_shm_interface.name) == 0)
+    {
+        pShm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+        primrose_log(VERBOSE_OK, "Connected to shared memory v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, "wp_presentation") == 0)
+    {
+        pPresentation =
+            wl_registry_bind(registry, name, &pPresentationInterface, 1);
+        // wp_presentation_add_listener
+        (void)wl_proxy_add_listener((struct wl_proxy *)pPresentation,
+                                    (void (**)(void))&pPresentationListener,
+                                    nullptr);
+        primrose_log(VERBOSE_OK, "Connected to presentation timing v%d.",
+                     version);
+        return;
+    }
+    else if (strcmp(interface, "zwp_relative_pointer_manager_v1") == 0)
+    {
+        pRelativeManager = wl_registry_bind(
+            registry, name, &pRelativePointerManagerInterface, 1);
+        getRelativePointer();
+        primrose_log(VERBOSE_OK, "Connected to relative pointer manager v%d.",
+                     version);
+        return;
+    }
+    else if (strcmp(interface, "zwp_pointer_constraints_v1") == 0)
+    {
+        pConstraints =
+            wl_registry_bind(registry, name, &pPointerConstraintsInterface, 1);
+        primrose_log(VERBOSE_OK, "Connected to pointer constraints v%d.",
+                     version);
+        return;
+    }
+    else if (strcmp(interface, "wp_viewporter") == 0)
+    {
+        pViewporter =
+            wl_registry_bind(registry, name, &pViewporterInterface, 1);
+        primrose_log(VERBOSE_OK, "Connected to viewporter v%d.", version);
+        return;
+    }
+    else if (strcmp(interface, "wp_fractional_scale_manager_v1") == 0)
+    {
+        pFractionalManager = wl_registry_bind(
+            registry, name, &pFractionalScaleManagerInterface, 1);
+        primrose_log(VERBOSE_OK, "Connected to fractional scaling v%d.",
+                     version);
+        return;
+    }
+    else if (strcmp(interface, "zwp_input_timestamps_manager_v1") == 0)
+    {
+        pTimestampsManager = wl_registry_bind(
+            registry, name, &pInputTimestampsManagerInterface, 1);
+        getAllTimestamps();
+        primrose_log(VERBOSE_OK, "Connected to input timestamps v%d.",
+                     version);
+        return;
+    }
+
+    primrose_log(VERBOSE, "Found unknown interface '%s'.", interface);
+}
+
+/**
+ * @copydoc wl_registry_listener::global_remove
+ */
+static void globalRemove(void *, struct wl_registry *, uint32_t name)
+{
+    // Of the globals we bind, only outputs are ever expected to go away.
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+    {
+        if (pOutputs[i].proxy == nullptr || pOutputs[i].info.id != name)
+            continue;
+
+        releaseOutput(&pOutputs[i]);
+        updateScale();
+        pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                    .type = HYACINTH_EVENT_OUTPUT_REMOVED,
+                                    .output = {name}});
+        primrose_log(VERBOSE, "Output device %u removed.", name);
+        return;
+    }
+}
+
+/**
+ * @var struct wl_registry_listener pRegistryListener
+ * @brief The listener for the Wayland registry object, through which we handle
+ * all base objects such as the XDG window manager base object or the output
+ * object.
+ * @since v0.0.0.2
+ */
+static const struct wl_registry_listener pRegistryListener = {&global,
+                                                              &globalRemove};
+
+/**
+ * @fn void setQueue(struct wl_event_queue *queue)
+ * @brief Move every object we own that receives events onto the given queue.
+ * Objects created from these later on inherit the queue automatically.
+ * @since v0.0.0.49
+ *
+ * @param[in] queue The queue to move to, or @c nullptr for the default queue.
+ */
+static void setQueue(struct wl_event_queue *queue)
+{
+    struct wl_proxy *proxies[] = {
+        (struct wl_proxy *)pRegistry,     (struct wl_proxy *)pSurface,
+        (struct wl_proxy *)pShell,
+        (struct wl_proxy *)pShellSurface, (struct wl_proxy *)pToplevel,
+        (struct wl_proxy *)pPresentation, (struct wl_proxy *)pFrameCallback,
+        (struct wl_proxy *)pShm,          (struct wl_proxy *)pShmPool,
+        (struct wl_proxy *)pSeat,         (struct wl_proxy *)pPointer,
+        (struct wl_proxy *)pKeyboard,     (struct wl_proxy *)pTouch,
+        (struct wl_proxy *)pRelativePointer, pConstraint,
+        pKeyboardTimestamps.proxy, pPointerTimestamps.proxy,
+        pTouchTimestamps.proxy, (struct wl_proxy *)pFractionalScale,
+        (struct wl_proxy *)pStartupCallback,
+        // Factories hand their queue down to whatever they make later.
+        (struct wl_proxy *)pRelativeManager, (struct wl_proxy *)pConstraints,
+        (struct wl_proxy *)pTimestampsManager,
+        (struct wl_proxy *)pFractionalManager,
+    };
+    for (size_t i = 0; i < sizeof(proxies) / sizeof(proxies[0]); ++i)
+        if (proxies[i] != nullptr) wl_proxy_set_queue(proxies[i], queue);
+    for (size_t i = 0; i < PENDING_PRESENTATIONS; ++i)
+        if (pPendingPresentations[i].feedback != nullptr)
+            wl_proxy_set_queue(
+                (struct wl_proxy *)pPendingPresentations[i].feedback, queue);
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+        if (pOutputs[i].proxy != nullptr)
+            wl_proxy_set_queue((struct wl_proxy *)pOutputs[i].proxy, queue);
+    for (size_t i = 0; i < SWAPCHAIN_MAX; ++i)
+        if (pShmBuffers[i].buffer != nullptr)
+            wl_proxy_set_queue((struct wl_proxy *)pShmBuffers[i].buffer, queue);
+    for (size_t i = 0; i < SHM_ORPHANS; ++i)
+        if (pShmOrphans[i] != nullptr)
+            wl_proxy_set_queue((struct wl_proxy *)pShmOrphans[i], queue);
+}
+
+/**
+ * @fn bool dispatchQueue(void)
+ * @brief Dispatch the reader thread's queue, and wake the application's thread
+ * if that produced any events.
+ * @since v0.0.0.49
+ *
+ * @return Whether or not dispatching succeeded.
+ */
+static bool dispatchQueue(void)
+{
+    uint32_t head = atomic_load_explicit(&pEvents.head, memory_order_relaxed);
+
+    (void)pthread_mutex_lock(&pDispatchLock);
+    bool staged = pStaged, relative = pRelativeStaged;
+    int count = wl_display_dispatch_queue_pending(pDisplay, pQueue);
+    applyConfigure();
+    // Motion merged into an event already staged was announced with it.
+    staged = (pStaged && !staged) || (pRelativeStaged && !relative);
+    (void)pthread_mutex_unlock(&pDispatchLock);
+
+    // Check for a release first; it must not be left behind if both happened.
+    if (atomic_exchange(&pReleased, false) || staged ||
+        atomic_load_explicit(&pEvents.head, memory_order_relaxed) != head)
+        (void)eventfd_write(pNotifyFD, 1);
+    return count != -1;
+}
+
+/**
+ * @fn struct wl_proxy *surfaceRequest(uint32_t opcode, const struct
+ * wl_interface *interface, union wl_argument *args)
+ * @brief Send one of the surface requests made every frame, with its arguments
+ * already laid out. This skips the variadic marshalling the protocol helpers
+ * go through; with @c Wire.c, the arguments are copied straight into the send
+ * buffer.
+ * @since v0.0.0.69
+ *
+ * @param[in] opcode The request.
+ * @param[in] interface The interface of the object it makes, if any.
+ * @param[in] args The arguments of the request.
+ * @return The object made, if any.
+ */
+static struct wl_proxy *surfaceRequest(uint32_t opcode,
+                                       const struct wl_interface *interface,
+                                       union wl_argument *args)
+{
+    return wl_proxy_marshal_array_flags(
+        (struct wl_proxy *)pSurface, opcode, interface,
+        wl_proxy_get_version((struct wl_proxy *)pSurface), 0, args);
+}
+
+/**
+ * @fn int flushDisplay(void)
+ * @brief Send whatever requests are buffered, without blocking.
+ * @since v0.0.0.67
+ *
+ * @return The events to wait on the connection for: @c POLLOUT joins @c
+ * POLLIN if the socket filled up, so the rest goes out as soon as it drains.
+ * This is -1 if the connection died.
+ */
+static int flushDisplay(void)
+{
+    if (wl_display_flush(pDisplay) != -1) return POLLIN;
+    return errno == EAGAIN ? POLLIN | POLLOUT : -1;
+}
+
+/**
+ * @fn void *reader(void *)
+ * @brief The body of the reader thread. This reads and dispatches events as
+ * soon as they arrive until told to stop via @ref pStopFD, or until the
+ * connection dies, in which case the window is closed.
+ * @since v0.0.0.49
+ *
+ * @return Nothing, ever.
+ */
+static void *reader(void *)
+{
+    struct pollfd fds[3] = {
+        {.fd = wl_display_get_fd(pDisplay), .events = POLLIN},
+        {.fd = pStopFD, .events = POLLIN},
+        {.fd = pRepeatFD, .events = POLLIN},
+    };
+
+    while (true)
+    {
+        if (wl_display_prepare_read_queue(pDisplay, pQueue) != 0)
+        {
+            if (!dispatchQueue()) break;
+            continue;
+        }
+
+        // A batch is the application's to send, whenever it's done with it.
+        int events = pBatching ? POLLIN : flushDisplay();
+        if (events == -1)
+        {
+            wl_display_cancel_read(pDisplay);
+            break;
+        }
+        fds[0].events = (short)events;
+
+        if (poll(fds, 3, -1) == -1)
+        {
+            wl_display_cancel_read(pDisplay);
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            wl_display_cancel_read(pDisplay);
+            return nullptr;
+        }
+        if (fds[2].revents != 0)
+        {
+            uint32_t head =
+                atomic_load_explicit(&pEvents.head, memory_order_relaxed);
+            (void)pthread_mutex_lock(&pDispatchLock);
+            repeatKeys();
+            (void)pthread_mutex_unlock(&pDispatchLock);
+            if (atomic_load_explicit(&pEvents.head, memory_order_relaxed) !=
+                head)
+                (void)eventfd_write(pNotifyFD, 1);
+        }
+        // Being writable only means the next time around can flush.
+        if ((fds[0].revents & ~POLLOUT) == 0)
+        {
+            wl_display_cancel_read(pDisplay);
+            continue;
+        }
+
+        if (wl_display_read_events(pDisplay) == -1 || !dispatchQueue()) break;
+    }
+
+    primrose_log(ERROR, "Lost the connection to the display server.");
+    pClose = true;
+    (void)pthread_mutex_lock(&pDispatchLock);
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_CLOSE});
+    (void)pthread_mutex_unlock(&pDispatchLock);
+    (void)eventfd_write(pNotifyFD, 1);
+    return nullptr;
+}
+
+/**
+ * @fn void releaseReader(void)
+ * @brief Free whatever resources the reader thread was given. The thread
+ * itself must already be dead, or never have been born.
+ * @since v0.0.0.49
+ */
+static void releaseReader(void)
+{
+    if (pStopFD != -1) (void)close(pStopFD);
+    if (pNotifyFD != -1) (void)close(pNotifyFD);
+    if (pQueue != nullptr) wl_event_queue_destroy(pQueue);
+    pStopFD = pNotifyFD = -1;
+    pQueue = nullptr;
+}
+
+/**
+ * @fn bool await(const struct timespec *timeout)
+ * @brief The reader thread's stand-in for @ref pump. This flushes whatever the
+ * application has requested, then waits for the reader to deliver a batch of
+ * events.
+ * @since v0.0.0.49
+ *
+ * @param[in] timeout The maximum time to wait, or @c nullptr to wait forever.
+ * @return Whether or not processing may continue, see @ref hyacinth_process.
+ */
+static bool await(const struct timespec *timeout)
+{
+    int events = flushDisplay();
+    if (events == -1) return false;
+
+    // The reader only waits to read, so a full socket is ours to drain.
+    struct pollfd fds[2] = {
+        {.fd = pNotifyFD, .events = POLLIN},
+        {.fd = wl_display_get_fd(pDisplay), .events = POLLOUT},
+    };
+    struct timespec left = timeout != nullptr ? *timeout : (struct timespec){0};
+    uint64_t mark = 0;
+    (void)lap(&mark);
+    while (ppoll(fds, events & POLLOUT ? 2 : 1,
+                 timeout != nullptr ? &left : nullptr, nullptr) > 0 &&
+           fds[0].revents == 0)
+    {
+        if ((events = flushDisplay()) == -1) return false;
+        // Draining doesn't grant any more time to wait.
+        shorten(&left, &mark);
+    }
+    if (fds[0].revents != 0)
+    {
+        eventfd_t count;
+        (void)eventfd_read(pNotifyFD, &count);
+    }
+    return !pClose;
+}
+
+/**
+ * @fn bool retireShm(void)
+ * @brief Free every buffer within the shared memory pool, so that the pool can
+ * be replaced. Those the compositor is still reading become orphans, to be
+ * destroyed once released. The caller must hold @ref pDispatchLock.
+ * @since v0.0.0.69
+ *
+ * @return Whether or not there was room for every orphan; if not, nothing has
+ * changed, and the caller must wait for a release before trying again.
+ */
+static bool retireShm(void)
+{
+    size_t busy = 0, room = 0;
+    for (size_t i = 0; i < SWAPCHAIN_MAX; ++i)
+        if (pShmBuffers[i].buffer != nullptr && pShmBuffers[i].busy) busy++;
+    for (size_t i = 0; i < SHM_ORPHANS; ++i)
+        if (pShmOrphans[i] == nullptr) room++;
+    if (busy > room) return false;
+
+    for (size_t i = 0, j = 0; i < SWAPCHAIN_MAX; ++i)
+    {
+        struct shm_buffer *buffer = &pShmBuffers[i];
+        if (buffer->buffer == nullptr) continue;
+        if (!buffer->busy) wl_buffer_destroy(buffer->buffer);
+        else
+        {
+            while (pShmOrphans[j] != nullptr) j++;
+            pShmOrphans[j] = buffer->buffer;
+        }
+        buffer->buffer = nullptr;
+        buffer->frame = 0;
+        buffer->busy = false;
+    }
+    pAcquired = -1;
+    return true;
+}
+
+/**
+ * @fn void releaseShm(void)
+ * @brief Free the shared memory pool and every buffer within it, orphans
+ * included. The caller must hold @ref pDispatchLock.
+ * @since v0.0.0.50
+ */
+static void releaseShm(void)
+{
+    for (size_t i = 0; i < SWAPCHAIN_MAX; ++i)
+    {
+        if (pShmBuffers[i].buffer != nullptr)
+            wl_buffer_destroy(pShmBuffers[i].buffer);
+        pShmBuffers[i].buffer = nullptr;
+        pShmBuffers[i].frame = 0;
+        pShmBuffers[i].busy = false;
+    }
+    for (size_t i = 0; i < SHM_ORPHANS; ++i)
+    {
+        if (pShmOrphans[i] != nullptr) wl_buffer_destroy(pShmOrphans[i]);
+        pShmOrphans[i] = nullptr;
+    }
+    if (pShmPool != nullptr) wl_shm_pool_destroy(pShmPool);
+    if (pShmMemory != nullptr) (void)munmap(pShmMemory, pShmSize);
+
+    pShmPool = nullptr;
+    pShmMemory = nullptr;
+    pShmSize = pShmSlot = 0;
+    pShmWidth = pShmHeight = pShmDepth = 0;
+    pAcquired = -1;
+}
+
+/**
+ * @fn void cutShm(size_t slot)
+ * @brief Cut a buffer of the current size and format out of its slot of the
+ * shared memory pool, replacing whatever buffer was there. That buffer must
+ * not be busy. The caller must hold @ref pDispatchLock.
+ * @since v0.0.0.69
+ *
+ * @param[in] slot The index of the slot.
+ */
+static void cutShm(size_t slot)
+{
+    struct shm_buffer *buffer = &pShmBuffers[slot];
+    if (buffer->buffer != nullptr) wl_buffer_destroy(buffer->buffer);
+
+    buffer->pixels = (uint8_t *)pShmMemory + slot * pShmSlot;
+    buffer->buffer = wl_shm_pool_create_buffer(
+        pShmPool, (int32_t)(slot * pShmSlot), (int32_t)pShmWidth,
+        (int32_t)pShmHeight, (int32_t)pShmWidth * 4, pShmFormat);
+    (void)wl_buffer_add_listener(buffer->buffer, &pBufferListener, buffer);
+    buffer->width = pShmWidth;
+    buffer->height = pShmHeight;
+    buffer->format = pShmFormat;
+    buffer->frame = 0;
+}
+
+/**
+ * @fn bool buildShm(uint32_t width, uint32_t height, uint32_t format)
+ * @brief Set the size and format of the buffers to come, (re)allocating the
+ * shared memory pool if it is too small for them. The pool is a single @c
+ * memfd, mapped once, which every buffer is a slice of. The caller must hold
+ * @ref pDispatchLock.
+ * @since v0.0.0.50
+ *
+ * @remark As of v0.0.0.63, a pool large enough already is kept, and only the
+ * buffers are recut from it; dynamic resolution changes the size often.
+ *
+ * @remark As of v0.0.0.69, no buffer is cut here at all. Each is recut within
+ * its own slot when next acquired, and only once the compositor has released
+ * it, see @ref cutShm. Should the pool need replacing while too many buffers
+ * are still busy, nothing changes, and the caller must wait for a release.
+ * Should the swapchain grow shallower, the buffers past its new depth are
+ * destroyed, as soon as the compositor lets go of them.
+ *
+ * @param[in] width The width of each buffer in pixels.
+ * @param[in] height The height of each buffer in pixels.
+ * @param[in] format The format of each buffer, as a @c wl_shm format code.
+ * @return Whether or not allocation succeeded.
+ */
+static bool buildShm(uint32_t width, uint32_t height, uint32_t format)
+{
+    size_t frame = (size_t)width * 4 * height;
+    if (__builtin_expect(frame * pSwapchainDepth > INT32_MAX, false))
+    {
+        primrose_log(ERROR, "Framebuffer of %ux%u is too large.", width,
+                     height);
+        return false;
+    }
+
+    if (pShmPool == nullptr || frame > pShmSlot ||
+        pShmSlot * pSwapchainDepth > pShmSize)
+    {
+        // Slots are only ever as large as the largest frame so far.
+        size_t slot = frame > pShmSlot ? frame : pShmSlot;
+        if (slot * pSwapchainDepth > INT32_MAX) slot = frame;
+        size_t size = slot * pSwapchainDepth;
+        if (!retireShm()) return true;
+
+        int fd = memfd_create("hyacinth", MFD_CLOEXEC);
+        if (__builtin_expect(fd == -1, false))
+        {
+            primrose_log(ERROR, "Failed to create framebuffer memory.");
+            return false;
+        }
+        if (__builtin_expect(ftruncate(fd, (off_t)size) == -1, false))
+        {
+            primrose_log(ERROR, "Failed to size framebuffer memory.");
+            (void)close(fd);
+            return false;
+        }
+
+        void *memory =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (__builtin_expect(memory == MAP_FAILED, false))
+        {
+            primrose_log(ERROR, "Failed to map framebuffer memory.");
+            (void)close(fd);
+            return false;
+        }
+
+        // Buffers cut from the old pool outlive it; the compositor keeps its
+        // memory for as long as any orphan does. The descriptor is duplicated
+        // when the request is marshalled, so ours can go right away.
+        if (pShmPool != nullptr) wl_shm_pool_destroy(pShmPool);
+        if (pShmMemory != nullptr) (void)munmap(pShmMemory, pShmSize);
+        pShmPool = wl_shm_create_pool(pShm, fd, (int32_t)size);
+        (void)close(fd);
+        pShmMemory = memory;
+        pShmSize = size;
+        pShmSlot = slot;
+    }
+    else
+    {
+        // Slots past a shallower swapchain are never acquired again. Those the
+        // compositor still holds are destroyed once released instead, and
+        // keep their slot until then, should the swapchain deepen again.
+        for (size_t i = pSwapchainDepth; i < SWAPCHAIN_MAX; ++i)
+        {
+            struct shm_buffer *buffer = &pShmBuffers[i];
+            if (buffer->buffer == nullptr || buffer->busy) continue;
+            wl_buffer_destroy(buffer->buffer);
+            buffer->buffer = nullptr;
+            buffer->frame = 0;
+        }
+    }
+
+    pShmWidth = width;
+    pShmHeight = height;
+    pShmFormat = format;
+    pShmDepth = pSwapchainDepth;
+    // Recut buffers have no history, so nothing short of everything will do.
+    pDamage = (struct damage){.full = true};
+    pAcquired = -1;
+    primrose_log(VERBOSE_OK, "Resized %u framebuffers to %ux%u.", pShmDepth,
+                 width, height);
+    return true;
+}
+
+/**
+ * @fn uint64_t area(const hyacinth_rect *rect)
+ * @brief Get the area of a rectangle.
+ * @since v0.0.0.52
+ *
+ * @param[in] rect The rectangle.
+ * @return The area in square pixels.
+ */
+static inline uint64_t area(const hyacinth_rect *rect)
+{
+    return (uint64_t)rect->width * (uint64_t)rect->height;
+}
+
+/**
+ * @fn void addDamage(hyacinth_rect rect)
+ * @brief Fold a clipped, non-empty rectangle into @ref pDamage. A rectangle is
+ * merged with any other whose bounding box wastes little area beyond what the
+ * two cover alone, which catches overlaps, neighbours, and near neighbours.
+ * Each merge can enable another, so the list is rescanned after each.
+ * @since v0.0.0.52
+ *
+ * @param[in] rect The rectangle to add.
+ */
+static void addDamage(hyacinth_rect rect)
+{
+    for (uint32_t i = 0; i < pDamage.count;)
+    {
+        hyacinth_rect *other = &pDamage.rects[i];
+        int32_t left = other->x < rect.x ? other->x : rect.x;
+        int32_t top = other->y < rect.y ? other->y : rect.y;
+        int32_t right = other->x + other->width > rect.x + rect.width
+                            ? other->x + other->width
+                            : rect.x + rect.width;
+        int32_t bottom = other->y + other->height > rect.y + rect.height
+                             ? other->y + other->height
+                             : rect.y + rect.height;
+        hyacinth_rect merged = {left, top, right - left, bottom - top};
+
+        uint64_t covered = area(other) + area(&rect);
+        if (area(&merged) > covered + covered / 8)
+        {
+            ++i;
+            continue;
+        }
+
+        rect = merged;
+        *other = pDamage.rects[--pDamage.count];
+        i = 0;
+    }
+
+    uint64_t total = area(&rect);
+    for (uint32_t i = 0; i < pDamage.count; ++i)
+        total += area(&pDamage.rects[i]);
+    if (pDamage.count == DAMAGE_MAX ||
+        total >= (uint64_t)pShmWidth * pShmHeight / 4 * 3)
+    {
+        pDamage.full = true;
+        return;
+    }
+    pDamage.rects[pDamage.count++] = rect;
+}
+
+/**
+ * @fn bool dispatchDisplay(const struct timespec *timeout)
+ * @brief Read and dispatch whatever events arrive on the connection within
+ * the given time, on the application's thread.
+ * @since v0.0.0.64
+ *
+ * @param[in] timeout The maximum time to wait, or @c nullptr to wait forever.
+ * @return Whether or not processing may continue, see @ref hyacinth_process.
+ */
+static bool dispatchDisplay(const struct timespec *timeout)
+{
+    static const struct timespec immediate = {0};
+    int dispatched = 0;
+    while (wl_display_prepare_read(pDisplay) != 0)
+    {
+        int count = wl_display_dispatch_pending(pDisplay);
+        if (__builtin_expect(count == -1, false)) return false;
+        dispatched += count;
+    }
+    if (dispatched > 0) timeout = &immediate;
+
+    int events = flushDisplay();
+    if (events == -1)
+    {
+        wl_display_cancel_read(pDisplay);
+        return false;
+    }
+
+    struct pollfd fds[2] = {
+        {.fd = wl_display_get_fd(pDisplay), .events = (short)events},
+        {.fd = pRepeatFD, .events = POLLIN},
+    };
+    int ready;
+    struct timespec left = timeout != nullptr ? *timeout : (struct timespec){0};
+    uint64_t mark = 0;
+    (void)lap(&mark);
+    // A full socket is drained as soon as it can take more, and the wait goes
+    // on for whatever time is left.
+    while ((ready = ppoll(fds, 2, timeout != nullptr ? &left : nullptr,
+                          nullptr)) > 0 &&
+           fds[0].revents == POLLOUT && fds[1].revents == 0)
+    {
+        if ((events = flushDisplay()) == -1)
+        {
+            wl_display_cancel_read(pDisplay);
+            return false;
+        }
+        fds[0].events = (short)events;
+        shorten(&left, &mark);
+    }
+    if (ready <= 0)
+    {
+        wl_display_cancel_read(pDisplay);
+        // Being interrupted by a signal is no different than timing out.
+        return (ready == 0 || errno == EINTR) && !pClose;
+    }
+
+    if (fds[1].revents != 0) repeatKeys();
+    if ((fds[0].revents & ~POLLOUT) == 0)
+    {
+        wl_display_cancel_read(pDisplay);
+        return !pClose;
+    }
+
+    if (__builtin_expect(wl_display_read_events(pDisplay) == -1, false))
+        return false;
+    return wl_display_dispatch_pending(pDisplay) != -1 && !pClose;
+}
+
+/**
+ * @fn bool suspended(void)
+ * @brief Check whether the window should be doing no work at all right now,
+ * being suspended while throttling is on.
+ * @since v0.0.0.65
+ *
+ * @return Whether or not the window is asleep.
+ */
+static inline bool suspended(void)
+{
+    return pThrottle && !pClose && (pStates & HYACINTH_STATE_SUSPENDED) != 0;
+}
+
+/**
+ * @fn bool pump(const struct timespec *timeout)
+ * @brief Dispatch any events already queued, then wait at most @p timeout for
+ * the compositor to send more, reading and dispatching those too. This is the
+ * single path every event processing function goes through.
+ * @since v0.0.0.45
+ *
+ * @remark If anything was dispatched before waiting, the wait is skipped
+ * entirely, mirroring @c wl_display_dispatch; a call never sleeps when it
+ * already has work to show for itself.
+ *
+ * @remark While @ref suspended, a call without a timeout keeps waiting until
+ * the window wakes again. A timeout is always kept to.
+ *
+ * @param[in] timeout The maximum time to wait for the display to become
+ * readable, or @c nullptr to wait forever.
+ * @return Whether or not processing may continue, see @ref hyacinth_process.
+ */
+static bool pump(const struct timespec *timeout)
+{
+    bool alive;
+    do
+    {
+        if (pThreaded) alive = await(timeout);
+        else
+        {
+            alive = dispatchDisplay(timeout);
+            applyConfigure();
+        }
+        // Nobody can see a suspended window, so there's no reason to wake,
+        // unless the caller asked to be back by some time.
+    } while (alive && timeout == nullptr && suspended());
+    ackLatest();
+    return alive;
+}
+
+/**
+ * @fn void fullscreen(struct wl_output *output)
+ * @brief Ask for the window to be made fullscreen. This takes no locks, so
+ * that it can be sent while dispatching.
+ * @since v0.0.0.69
+ *
+ * @param[in] output The output to go fullscreen upon, or @c nullptr to leave
+ * it to the compositor.
+ */
+static void fullscreen(struct wl_output *output)
+{
+    // xdg_toplevel_set_fullscreen
+    (void)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pToplevel, 11, nullptr,
+        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, output);
+}
+
+/**
+ * @fn bool buildWindow(void)
+ * @brief Build the window itself, once every global has been bound, and
+ * commit it so that the compositor configures it. Nothing here waits on the
+ * compositor; it all goes out at once.
+ * @since v0.0.0.69
+ *
+ * @return Whether or not the required globals were found.
+ */
+static bool buildWindow(void)
+{
+    if (__builtin_expect(pFoundInterfaces != pRequiredInterfaces, false))
+    {
+        primrose_log(ERROR, "Could not find the required interfaces.");
+        return false;
+    }
+    pStartup.registry = lap(&pStartupMark);
+
+    // The presentation clock is known by now; repeats should share it.
+    pRepeatFD = timerfd_create(pPresentationClock, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (pRepeatFD == -1)
+        pRepeatFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (__builtin_expect(pRepeatFD == -1, false))
+        primrose_log(WARNING, "Failed to create key repeat timer.");
+
+    pSurface = wl_compositor_create_surface(pCompositor);
+    (void)wl_surface_add_listener(pSurface, &pSurfaceListener, nullptr);
+    hyacinth_setOpaque(true);
+    if (pViewporter != nullptr)
+        // wp_viewporter_get_viewport
+        pViewport = (struct wp_viewport *)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pViewporter, 1, &pViewportInterface,
+            wl_proxy_get_version((struct wl_proxy *)pViewporter), 0, nullptr,
+            pSurface);
+    // Fractional scales are useless without a viewport to apply them.
+    if (pFractionalManager != nullptr && pViewport != nullptr)
+    {
+        // wp_fractional_scale_manager_v1_get_fractional_scale
+        pFractionalScale =
+            (struct wp_fractional_scale_v1 *)wl_proxy_marshal_flags(
+                (struct wl_proxy *)pFractionalManager, 1,
+                &pFractionalScaleInterface,
+                wl_proxy_get_version((struct wl_proxy *)pFractionalManager), 0,
+                nullptr, pSurface);
+        // wp_fractional_scale_v1_add_listener
+        if (pFractionalScale != nullptr)
+            (void)wl_proxy_add_listener(
+                (struct wl_proxy *)pFractionalScale,
+                (void (**)(void))&pFractionalScaleListener, nullptr);
+    }
+    // xdg_wm_base_get_xdg_surface
+    pShellSurface = (struct xdg_surface *)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pShell, 2, &pXDGSurfaceInterface,
+        wl_proxy_get_version((struct wl_proxy *)pShell), 0, nullptr, pSurface);
+    // xdg_surface_add_listener
+    (void)wl_proxy_add_listener((struct wl_proxy *)pShellSurface,
+                                (void (**)(void))&pShellSurfaceListener,
+                                nullptr);
+    // xdg_surface_get_toplevel
+    pToplevel = (struct xdg_toplevel *)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pShellSurface, 1, &pXDGToplevelInterface,
+        wl_proxy_get_version((struct wl_proxy *)pShellSurface), 0, nullptr);
+    // xdg_toplevel_add_listener
+    (void)wl_proxy_add_listener((struct wl_proxy *)pToplevel,
+                                (void (**)(void))&pToplevelListener, nullptr);
+
+    // xdg_toplevel_set_title
+    (void)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pToplevel, 2, nullptr,
+        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, pTitle);
+    // xdg_toplevel_set_app_id
+    (void)wl_proxy_marshal_flags(
+        (struct wl_proxy *)pToplevel, 3, nullptr,
+        wl_proxy_get_version((struct wl_proxy *)pToplevel), 0, pTitle);
+    // This may be run by the reader thread, which holds the dispatch lock.
+    fullscreen(nullptr);
+    // The window is only configured once it's been committed without a
+    // buffer; this goes out with everything above.
+    wl_surface_commit(pSurface);
+    free(pTitle);
+    pTitle = nullptr;
+    // Whatever was made from the globals landed on the default queue.
+    if (pQueue != nullptr) setQueue(pQueue);
+    pStartup.surface = lap(&pStartupMark);
+    return true;
+}
+
+/**
+ * @copydoc wl_callback_listener::done
+ */
+static void startupDone(void *, struct wl_callback *c, uint32_t)
+{
+    wl_callback_destroy(c);
+    pStartupCallback = nullptr;
+    if (__builtin_expect(!buildWindow(), false))
+    {
+        pClose = true;
+        pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                    .type = HYACINTH_EVENT_CLOSE});
+        return;
+    }
+    pushEvent(&(hyacinth_event){.time = hyacinth_getTime(),
+                                .type = HYACINTH_EVENT_CONNECTED});
+}
+
+/**
+ * @var struct wl_callback_listener pStartupListener
+ * @brief The listener for the callback marking the end of the registry's
+ * globals.
+ * @since v0.0.0.69
+ *
+ * @copydoc wl_callback_listener
+ */
+static const struct wl_callback_listener pStartupListener = {&startupDone};
+
+bool hyacinth_createAsync(const char *title)
+{
+    (void)lap(&pStartupMark);
+    pStartup = (hyacinth_startup){0};
+    pConfigured = false;
+    pAck = pAcked = pAcquiredAck = 0;
+
+    pTitle = strdup(title);
+    if (__builtin_expect(pTitle == nullptr, false))
+    {
+        primrose_log(ERROR, "Failed to allocate window title.");
+        return false;
+    }
+
+    pDisplay = wl_display_connect(nullptr);
+    if (__builtin_expect(pDisplay == nullptr, false))
+    {
+        primrose_log(ERROR, "Failed to connect to display server.");
+        free(pTitle);
+        pTitle = nullptr;
+        return false;
+    }
+    pStartup.connect = lap(&pStartupMark);
+
+    // Globals are bound as they're announced, and the window is built the
+    // moment the last one is in.
+    pRegistry = wl_display_get_registry(pDisplay);
+    (void)wl_registry_add_listener(pRegistry, &pRegistryListener, nullptr);
+    pStartupCallback = wl_display_sync(pDisplay);
+    (void)wl_callback_add_listener(pStartupCallback, &pStartupListener,
+                                   nullptr);
+    return wl_display_flush(pDisplay) != -1 || errno == EAGAIN;
+}
+
+bool hyacinth_create(const char *title)
+{
+    if (!hyacinth_createAsync(title)) return false;
+
+    while (!pConfigured)
+    {
+        if (__builtin_expect(!dispatchDisplay(nullptr), false))
+        {
+            primrose_log(ERROR, "Window was never configured.");
+            return false;
+        }
+        applyConfigure();
+    }
+    // Nothing may be committed with a buffer before this, so it can't wait.
+    ackConfigure(pAck);
+    return true;
+}
+
+void hyacinth_destroy(void)
+{
+    hyacinth_stopReader();
+    releaseShm();
+    if (pShm != nullptr) wl_shm_destroy(pShm);
+    destroyProxy(&pConstraint);
+    destroyProxy((struct wl_proxy **)&pRelativePointer);
+    destroyProxy((struct wl_proxy **)&pRelativeManager);
+    destroyProxy((struct wl_proxy **)&pConstraints);
+    destroyProxy(&pKeyboardTimestamps.proxy);
+    destroyProxy(&pPointerTimestamps.proxy);
+    destroyProxy(&pTouchTimestamps.proxy);
+    destroyProxy((struct wl_proxy **)&pTimestampsManager);
+    destroyProxy((struct wl_proxy **)&pFractionalScale);
+    destroyProxy((struct wl_proxy **)&pFractionalManager);
+    destroyProxy((struct wl_proxy **)&pViewport);
+    destroyProxy((struct wl_proxy **)&pViewporter);
+    releaseKeymap();
+    if (pRepeatFD != -1) (void)close(pRepeatFD);
+    pRepeatFD = -1;
+    // wl_pointer_release, wl_keyboard_release, wl_touch_release
+    if (pPointer != nullptr) releaseDevice(pPointer, 1);
+    if (pKeyboard != nullptr) releaseDevice(pKeyboard, 0);
+    if (pTouch != nullptr) releaseDevice(pTouch, 0);
+    if (pSeat != nullptr)
+    {
+        if (wl_seat_get_version(pSeat) >= WL_SEAT_RELEASE_SINCE_VERSION)
+            wl_seat_release(pSeat);
+        else wl_seat_destroy(pSeat);
+    }
+    if (pFrameCallback != nullptr) wl_callback_destroy(pFrameCallback);
+    for (size_t i = 0; i < PENDING_PRESENTATIONS; ++i)
+        if (pPendingPresentations[i].feedback != nullptr)
+            wl_proxy_destroy(
+                (struct wl_proxy *)pPendingPresentations[i].feedback);
+    // wp_presentation_destroy
+    if (pPresentation != nullptr)
+        (void)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pPresentation, 0, nullptr,
+            wl_proxy_get_version((struct wl_proxy *)pPresentation),
+            WL_MARSHAL_FLAG_DESTROY);
+
+    // An asynchronously created window may not have been built yet.
+    if (pStartupCallback != nullptr) wl_callback_destroy(pStartupCallback);
+    pStartupCallback = nullptr;
+    free(pTitle);
+    pTitle = nullptr;
+    if (pSurface != nullptr)
+    {
+        // xdg_toplevel_destroy
+        (void)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pToplevel, 0, nullptr,
+            wl_proxy_get_version((struct wl_proxy *)pToplevel),
+            WL_MARSHAL_FLAG_DESTROY);
+        // xdg_surface_destroy
+        (void)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pShellSurface, 0, nullptr,
+            wl_proxy_get_version((struct wl_proxy *)pShellSurface),
+            WL_MARSHAL_FLAG_DESTROY);
+        wl_surface_destroy(pSurface);
+    }
+    // xdg_wm_base_destroy
+    if (pShell != nullptr)
+        (void)wl_proxy_marshal_flags(
+            (struct wl_proxy *)pShell, 0, nullptr,
+            wl_proxy_get_version((struct wl_proxy *)pShell),
+            WL_MARSHAL_FLAG_DESTROY);
+    if (pCompositor != nullptr) wl_compositor_destroy(pCompositor);
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+        if (pOutputs[i].proxy != nullptr) releaseOutput(&pOutputs[i]);
+    wl_registry_destroy(pRegistry);
+    wl_display_disconnect(pDisplay);
+}
+
+void hyacinth_getStartup(hyacinth_startup *startup) { *startup = pStartup; }
+
+bool hyacinth_process(void) { return pump(nullptr); }
+
+bool hyacinth_poll(void)
+{
+    static const struct timespec immediate = {0};
+    return pump(&immediate);
+}
+
+bool hyacinth_processTimeout(uint64_t ns)
+{
+    struct timespec timeout = {.tv_sec = (time_t)(ns / 1000000000),
+                               .tv_nsec = (long)(ns % 1000000000)};
+    return pump(&timeout);
+}
+
+int hyacinth_getFD(void)
+{
+    return pThreaded ? pNotifyFD : wl_display_get_fd(pDisplay);
+}
+
+bool hyacinth_prepareRead(void)
+{
+    if (pThreaded) return !pClose;
+
+    while (wl_display_prepare_read(pDisplay) != 0)
+        if (__builtin_expect(wl_display_dispatch_pending(pDisplay) == -1, false))
+            return false;
+    return true;
+}
+
+bool hyacinth_readEvents(void)
+{
+    if (pThreaded)
+    {
+        eventfd_t count;
+        (void)eventfd_read(pNotifyFD, &count);
+        return true;
+    }
+
+    return wl_display_read_events(pDisplay) != -1;
+}
+
+void hyacinth_cancelRead(void)
+{
+    if (!pThreaded) wl_display_cancel_read(pDisplay);
+}
+
+int hyacinth_getRepeatFD(void) { return pThreaded ? -1 : pRepeatFD; }
+
+bool hyacinth_dispatch(void)
+{
+    if (pThreaded) return !pClose;
+    repeatKeys();
+    bool alive = wl_display_dispatch_pending(pDisplay) != -1 && !pClose;
+    applyConfigure();
+    ackLatest();
+    return alive;
+}
+
+void hyacinth_beginBatch(void) { pBatching = true; }
+
+bool hyacinth_flush(bool *pending)
+{
+    pBatching = false;
+    *pending = false;
+    if (wl_display_flush(pDisplay) != -1) return true;
+
+    *pending = errno == EAGAIN;
+    return *pending;
+}
+
+bool hyacinth_requestFrame(void)
+{
+    // Whoever draws for themselves resizes before this, and commits after.
+    ackLatest();
+
+    // A suspended window is never painted, so its frames are never due.
+    if (suspended()) return false;
+
+    (void)pthread_mutex_lock(&pDispatchLock);
+    if (pFrameCallback == nullptr)
+    {
+        // wl_surface_frame
+        pFrameCallback = (struct wl_callback *)surfaceRequest(
+            3, &wl_callback_interface, (union wl_argument[]){{.n = 0}});
+        if (__builtin_expect(pFrameCallback != nullptr, true))
+            (void)wl_callback_add_listener(pFrameCallback, &pFrameListener,
+                                           nullptr);
+    }
+    bool requested = pFrameCallback != nullptr;
+    (void)pthread_mutex_unlock(&pDispatchLock);
+
+    return requested;
+}
+
+bool hyacinth_frameReady(uint32_t *timestamp)
+{
+    if (!atomic_exchange(&pFrameReady, false)) return false;
+
+    if (timestamp != nullptr) *timestamp = pFrameTime;
+    return true;
+}
+
+bool hyacinth_waitFrame(uint32_t *timestamp)
+{
+    while (!pFrameReady)
+    {
+        (void)pthread_mutex_lock(&pDispatchLock);
+        bool pending = pFrameCallback != nullptr;
+        (void)pthread_mutex_unlock(&pDispatchLock);
+
+        if (!pending) break;
+        if (!pump(nullptr)) return false;
+    }
+
+    (void)hyacinth_frameReady(timestamp);
+    return !pClose;
+}
+
+bool hyacinth_requestPresentation(void)
+{
+    if (pPresentation == nullptr) return false;
+
+    (void)pthread_mutex_lock(&pDispatchLock);
+    bool requested = false;
+    for (size_t i = 0; i < PENDING_PRESENTATIONS && !requested; ++i)
+    {
+        struct presentation_slot *slot = &pPendingPresentations[i];
+        if (slot->feedback != nullptr) continue;
+
+        // wp_presentation_feedback
+        slot->feedback =
+            (struct wp_presentation_feedback *)wl_proxy_marshal_flags(
+                (struct wl_proxy *)pPresentation, 1,
+                &pPresentationFeedbackInterface,
+                wl_proxy_get_version((struct wl_proxy *)pPresentation), 0,
+                pSurface, nullptr);
+        if (__builtin_expect(slot->feedback == nullptr, false)) break;
+        // wp_presentation_feedback_add_listener
+        (void)wl_proxy_add_listener((struct wl_proxy *)slot->feedback,
+                                    (void (**)(void))&pFeedbackListener, slot);
+        slot->submitted = hyacinth_getTime();
+        requested = true;
+    }
+    (void)pthread_mutex_unlock(&pDispatchLock);
+
+    return requested;
+}
+
+bool hyacinth_nextPresentation(hyacinth_presentation *presentation)
+{
+    uint64_t tail = pPresentationTail;
+    if (tail == pPresentationHead) return false;
+
+    *presentation = pPresentations[tail & (PRESENTATION_RING - 1)];
+    pPresentationTail = tail + 1;
+    return true;
+}
+
+uint64_t hyacinth_predictVblank(void)
+{
+    uint64_t last = pLastPresented;
+    uint32_t refresh = pLastRefresh;
+    if (last == 0 || refresh == 0) return 0;
+
+    uint64_t now = hyacinth_getTime();
+    if (now < last) return last;
+    return last + ((now - last) / refresh + 1) * refresh;
+}
+
+uint64_t hyacinth_getTime(void)
+{
+    struct timespec now;
+    (void)clock_gettime(pPresentationClock, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+bool hyacinth_nextEvent(hyacinth_event *event)
+{
+    // The reader thread can't acknowledge anything, so this does it instead.
+    ackLatest();
+    if (ringPop(&pEvents, event)) return true;
+
+    // Merged motion is the newest event there is, so once nothing older is
+    // left it can be handed out without breaking the order. Until then it
+    // stays staged, so that more motion can still join it.
+    (void)pthread_mutex_lock(&pDispatchLock);
+    bool popped = ringPop(&pEvents, event);
+    if (!popped && pStaged)
+    {
+        *event = pStagedMotion;
+        pStaged = false;
+        popped = true;
+    }
+    else if (!popped && pRelativeStaged)
+    {
+        *event = pStagedRelative;
+        pRelativeStaged = false;
+        popped = true;
+    }
+    (void)pthread_mutex_unlock(&pDispatchLock);
+    return popped;
+}
+
+void hyacinth_coalesceMotion(bool coalesce, bool history)
+{
+    pKeepHistory = coalesce && history;
+    pCoalesce = coalesce;
+}
+
+bool hyacinth_nextMotion(hyacinth_event *event)
+{
+    return ringPop(&pMotionHistory, event);
+}
+
+/**
+ * @fn bool constrain(bool lock, bool enable)
+ * @brief Create or destroy a persistent pointer lock or confinement.
+ * @since v0.0.0.56
+ *
+ * @param[in] lock Whether the constraint is a lock or a confinement.
+ * @param[in] enable Whether to create or destroy it.
+ * @return Whether or not the request could be made.
+ */
+static bool constrain(bool lock, bool enable)
+{
+    (void)pthread_mutex_lock(&pDispatchLock);
+    bool success = false;
+    if (!enable)
+    {
+        if (pConstraint == nullptr || pLocked == lock) success = true;
+        if (pConstraint != nullptr && pLocked == lock)
+            destroyProxy(&pConstraint);
+    }
+    else if (pConstraints != nullptr && pPointer != nullptr &&
+             (pConstraint == nullptr || pLocked == lock))
+    {
+        success = true;
+        if (pConstraint == nullptr)
+        {
+            // zwp_pointer_constraints_v1_lock_pointer,
+            // zwp_pointer_constraints_v1_confine_pointer
+            // The trailing two is the persistent lifetime.
+            pConstraint = wl_proxy_marshal_flags(
+                (struct wl_proxy *)pConstraints, lock ? 1 : 2,
+                lock ? &pLockedPointerInterface : &pConfinedPointerInterface,
+                wl_proxy_get_version((struct wl_proxy *)pConstraints), 0,
+                nullptr, pSurface, pPointer, nullptr, 2);
+            success = pConstraint != nullptr;
+            if (__builtin_expect(success, true))
+                // zwp_locked_pointer_v1_add_listener,
+                // zwp_confined_pointer_v1_add_listener
+                (void)wl_proxy_add_listener(
+                    pConstraint, (void (**)(void))&pConstraintListener,
+                    nullptr);
+            pLocked = lock;
+        }
+    }
+    // A lock hides all but relative motion, so that's made available.
+    getRelativePointer();
+    (void)pthread_mutex_unlock(&pDispatchLock);
+
+    return success;
+}
+
+bool hyacinth_lockPointer(bool lock) { return constrain(true, lock); }
+
+bool hyacinth_confinePointer(bool confine) { return constrain(false, confine); }
+
+bool hyacinth_setRelativeMotion(bool relative)
+{
+    (void)pthread_mutex_lock(&pDispatchLock);
+    pWantRelative = relative;
+    getRelativePointer();
+    bool available = !relative || pRelativePointer != nullptr;
+    (void)pthread_mutex_unlock(&pDispatchLock);
+
+    return available;
+}
+
+bool hyacinth_startReader(void)
+{
+    if (pThreaded) return true;
+
+    pQueue = wl_display_create_queue(pDisplay);
+    pStopFD = eventfd(0, EFD_CLOEXEC);
+    pNotifyFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (__builtin_expect(
+            pQueue == nullptr || pStopFD == -1 || pNotifyFD == -1, false))
+    {
+        primrose_log(ERROR, "Failed to allocate the reader thread.");
+        releaseReader();
+        return false;
+    }
+
+    // Anything already queued for us would otherwise be stranded.
+    (void)wl_display_dispatch_pending(pDisplay);
+    applyConfigure();
+    setQueue(pQueue);
+    if (__builtin_expect(pthread_create(&pReader, nullptr, &reader, nullptr),
+                         false))
+    {
+        primrose_log(ERROR, "Failed to start the reader thread.");
+        setQueue(nullptr);
+        releaseReader();
+        return false;
+    }
+    (void)pthread_setname_np(pReader, "hyacinth");
+
+    pThreaded = true;
+    primrose_log(VERBOSE_OK, "Started the reader thread.");
+    return true;
+}
+
+void hyacinth_stopReader(void)
+{
+    if (!pThreaded) return;
+
+    (void)eventfd_write(pStopFD, 1);
+    (void)pthread_join(pReader, nullptr);
+    (void)wl_display_dispatch_queue_pending(pDisplay, pQueue);
+    setQueue(nullptr);
+    releaseReader();
+
+    pThreaded = false;
+    primrose_log(VERBOSE_OK, "Stopped the reader thread.");
+}
+
+bool hyacinth_acquireBuffer(hyacinth_buffer *buffer)
+{
+    // Read before the size, which is always applied before the serial is.
+    uint64_t ack = pAck;
+    uint32_t width = pRenderWidth, height = pRenderHeight;
+    if (width == 0 || height == 0)
+    {
+        width = pWidth;
+        height = pHeight;
+    }
+    if (pShm == nullptr || width == 0 || height == 0) return false;
+
+    uint32_t format =
+        pOpaque ? WL_SHM_FORMAT_XRGB8888 : WL_SHM_FORMAT_ARGB8888;
+    for (bool waited = false; width != pShmWidth || height != pShmHeight ||
+                              pShmDepth != pSwapchainDepth ||
+                              format != pShmFormat;
+         waited = true)
+    {
+        // A new pool can wait on the compositor letting go of the old one.
+        if (waited && !pump(nullptr)) return false;
+        (void)pthread_mutex_lock(&pDispatchLock);
+        bool built = buildShm(width, height, format);
+        (void)pthread_mutex_unlock(&pDispatchLock);
+        if (!built) return false;
+    }
+
+    uint64_t start = 0;
+    while (pAcquired == -1)
+    {
+        // The most recently presented free buffer has the least to redraw.
+        for (int32_t i = 0; i < (int32_t)pShmDepth; ++i)
+            if (!pShmBuffers[i].busy &&
+                (pAcquired == -1 ||
+                 pShmBuffers[i].frame > pShmBuffers[pAcquired].frame))
+                pAcquired = i;
+        if (pAcquired != -1)
+        {
+            // Only a buffer the compositor is done with may be recut.
+            struct shm_buffer *acquired = &pShmBuffers[pAcquired];
+            if (acquired->buffer == nullptr ||
+                acquired->width != pShmWidth ||
+                acquired->height != pShmHeight ||
+                acquired->format != pShmFormat)
+            {
+                (void)pthread_mutex_lock(&pDispatchLock);
+                cutShm((size_t)pAcquired);
+                (void)pthread_mutex_unlock(&pDispatchLock);
+            }
+            if (start != 0)
+                pSwapchainStats.waited += hyacinth_getTime() - start;
+            pSwapchainStats.acquired++;
+            break;
+        }
+
+        if (start == 0)
+        {
+            start = hyacinth_getTime();
+            pSwapchainStats.starved++;
+        }
+        if (!pump(nullptr)) return false;
+    }
+
+    pAcquiredAck = ack;
+    uint64_t frame = pShmBuffers[pAcquired].frame;
+    *buffer = (hyacinth_buffer){
+        .pixels = pShmBuffers[pAcquired].pixels,
+        .width = pShmWidth,
+        .height = pShmHeight,
+        .stride = pShmWidth * 4,
+        .format = pShmFormat,
+        .age = frame == 0 ? 0 : (uint32_t)(pPresentCount + 1 - frame),
+    };
+    return true;
+}
+
+void hyacinth_damage(const hyacinth_rect *rect)
+{
+    if (pDamage.full) return;
+
+    int32_t left = rect->x < 0 ? 0 : rect->x;
+    int32_t top = rect->y < 0 ? 0 : rect->y;
+    int64_t right = (int64_t)rect->x + rect->width;
+    int64_t bottom = (int64_t)rect->y + rect->height;
+    if (right > pShmWidth) right = pShmWidth;
+    if (bottom > pShmHeight) bottom = pShmHeight;
+    if (right <= left || bottom <= top) return;
+
+    addDamage((hyacinth_rect){left, top, (int32_t)(right - left),
+                              (int32_t)(bottom - top)});
+}
+
+bool hyacinth_present(void)
+{
+    if (pAcquired == -1) return false;
+
+    struct shm_buffer *buffer = &pShmBuffers[pAcquired];
+    pAcquired = -1;
+    buffer->frame = ++pPresentCount;
+    buffer->busy = true;
+
+    if (pDamage.full || pDamage.count == 0)
+    {
+        pDamage.count = 1;
+        pDamage.rects[0] = (hyacinth_rect){0, 0, INT32_MAX, INT32_MAX};
+    }
+
+    // Without a viewport, the compositor must be told the buffer's scale, and
+    // that scale must divide its size.
+    uint32_t version = wl_proxy_get_version((struct wl_proxy *)pSurface);
+    int32_t scale = pScale;
+    if (pViewport == nullptr &&
+        version >= WL_SURFACE_SET_BUFFER_SCALE_SINCE_VERSION)
+        wl_surface_set_buffer_scale(
+            pSurface, pShmWidth % scale == 0 && pShmHeight % scale == 0
+                          ? scale
+                          : 1);
+    // wl_surface_attach
+    (void)surfaceRequest(1, nullptr,
+                         (union wl_argument[]){
+                             {.o = (struct wl_object *)buffer->buffer},
+                             {.i = 0},
+                             {.i = 0}});
+    // Before version four, damage is in surface coordinates, which only match
+    // the buffer's if it isn't scaled.
+    bool inBuffer = version >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION;
+    if (!inBuffer && (pViewport != nullptr || scale != 1))
+    {
+        pDamage.count = 1;
+        pDamage.rects[0] = (hyacinth_rect){0, 0, INT32_MAX, INT32_MAX};
+    }
+    for (uint32_t i = 0; i < pDamage.count; ++i)
+    {
+        hyacinth_rect *rect = &pDamage.rects[i];
+        // wl_surface_damage_buffer, wl_surface_damage
+        (void)surfaceRequest(inBuffer ? 9 : 2, nullptr,
+                             (union wl_argument[]){{.i = rect->x},
+                                                   {.i = rect->y},
+                                                   {.i = rect->width},
+                                                   {.i = rect->height}});
+    }
+    // The buffer was made for this configuration, so this commit carries it.
+    ackConfigure(pAcquiredAck);
+    // wl_surface_commit, which takes no arguments
+    (void)surfaceRequest(6, nullptr, (union wl_argument[1]){{.u = 0}});
+    pDamage = (struct damage){0};
+
+    // Whatever doesn't fit goes out with the next processing of events.
+    return pBatching || flushDisplay() != -1;
+}
+
+bool hyacinth_setSwapchainDepth(uint32_t depth)
+{
+    if (depth < 2 || depth > SWAPCHAIN_MAX) return false;
+
+    pSwapchainDepth = depth;
+    return true;
+}
+
+void hyacinth_getSwapchainStats(hyacinth_swapchain_stats *stats)
+{
+    *stats = pSwapchainStats;
+}
+
+void hyacinth_setOpaque(bool opaque)
+{
+    if (!opaque)
+    {
+        hyacinth_setOpaqueRegion(nullptr, 0);
+        return;
+    }
+
+    hyacinth_setOpaqueRegion(&(hyacinth_rect){0, 0, INT32_MAX, INT32_MAX}, 1);
+    pOpaque = true;
+}
+
+void hyacinth_setOpaqueRegion(const hyacinth_rect *rects, uint32_t count)
+{
+    pOpaque = false;
+    if (count == 0)
+    {
+        wl_surface_set_opaque_region(pSurface, nullptr);
+        return;
+    }
+
+    struct wl_region *region = wl_compositor_create_region(pCompositor);
+    for (uint32_t i = 0; i < count; ++i)
+        wl_region_add(region, rects[i].x, rects[i].y, rects[i].width,
+                      rects[i].height);
+    wl_surface_set_opaque_region(pSurface, region);
+    wl_region_destroy(region);
+}
+
+uint32_t hyacinth_getOutputs(hyacinth_output *outputs, uint32_t max)
+{
+    uint32_t count = 0;
+    (void)pthread_mutex_lock(&pDispatchLock);
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX && count < max; ++i)
+        if (pOutputs[i].proxy != nullptr) outputs[count++] = pOutputs[i].info;
+    (void)pthread_mutex_unlock(&pDispatchLock);
+    return count;
+}
+
+/**
+ * @fn const struct output *currentOutput(void)
+ * @brief Get the output the window is shown on, as described by @ref
+ * hyacinth_getOutput. The caller must hold @ref pDispatchLock.
+ * @since v0.0.0.61
+ *
+ * @return The output, or @c nullptr if there are none.
+ */
+static const struct output *currentOutput(void)
+{
+    const struct output *current = nullptr;
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX; ++i)
+    {
+        const struct output *output = &pOutputs[i];
+        if (output->proxy == nullptr) continue;
+
+        if (current == nullptr ||
+            (output->entered &&
+             (!current->entered || output->order < current->order)) ||
+            (!output->entered && !current->entered &&
+             output->info.id < current->info.id))
+            current = output;
+    }
+    return current;
+}
+
+bool hyacinth_getOutput(uint32_t id, hyacinth_output *output)
+{
+    const struct output *found = nullptr;
+    (void)pthread_mutex_lock(&pDispatchLock);
+    if (id == 0) found = currentOutput();
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX && id != 0; ++i)
+        if (pOutputs[i].proxy != nullptr && pOutputs[i].info.id == id)
+            found = &pOutputs[i];
+    if (found != nullptr) *output = found->info;
+    (void)pthread_mutex_unlock(&pDispatchLock);
+    return found != nullptr;
+}
+
+uint32_t hyacinth_getRefresh(void)
+{
+    uint32_t period = pLastRefresh;
+    // Round to the nearest millihertz.
+    if (period != 0)
+        return (uint32_t)(((uint64_t)1000000000000 + period / 2) / period);
+
+    hyacinth_output output;
+    if (!hyacinth_getOutput(0, &output) || output.refresh <= 0) return 0;
+    return (uint32_t)output.refresh;
+}
+
+bool hyacinth_setFullscreen(uint32_t output)
+{
+    struct wl_output *proxy = nullptr;
+    (void)pthread_mutex_lock(&pDispatchLock);
+    for (size_t i = 0; i < HYACINTH_OUTPUT_MAX && output != 0; ++i)
+        if (pOutputs[i].proxy != nullptr && pOutputs[i].info.id == output)
+            proxy = pOutputs[i].proxy;
+    if (output == 0 || proxy != nullptr) fullscreen(proxy);
+    (void)pthread_mutex_unlock(&pDispatchLock);
+    return output == 0 || proxy != nullptr;
 }
 
+uint32_t hyacinth_getState(void) { return pStates; }
+
+void hyacinth_setThrottle(bool throttle) { pThrottle = throttle; }
+
 void hyacinth_getSize(uint32_t *width, uint32_t *height)
 {
     *width = pWidth;
     *height = pHeight;
 }
 
+uint64_t hyacinth_getSizeGeneration(void) { return pSizeGeneration; }
+
+uint32_t hyacinth_getScale(void) { return currentScale(); }
+
+bool hyacinth_setViewport(uint32_t width, uint32_t height, uint32_t destWidth,
+                          uint32_t destHeight)
+{
+    if (pViewport == nullptr) return false;
+    if (width > INT32_MAX || height > INT32_MAX || destWidth > INT32_MAX ||
+        destHeight > INT32_MAX)
+        return false;
+
+    pRenderWidth = width;
+    pRenderHeight = height;
+    if (destWidth != pDestWidth || destHeight != pDestHeight)
+    {
+        pDestWidth = destWidth;
+        pDestHeight = destHeight;
+        applyDestination();
+    }
+    return true;
+}
+
 void hyacinth_getData(void **data)
 {
     data[0] = pDisplay;
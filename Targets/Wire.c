@@ -0,0 +1,1771 @@
+/**
+ * @file Wire.c
+ * @authors Israfil Argos
+ * @brief This file provides an optional, built-in implementation of the parts
+ * of the Wayland client library used by @c Wayland.c, speaking the wire
+ * protocol over the compositor's socket itself. Building it alongside @c
+ * Wayland.c in place of linking @c libwayland-client leaves the window with no
+ * Wayland library to load at all, so it may be linked fully statically. This
+ * only depends upon the C standard library, the POSIX @c errno.h, @c fcntl.h,
+ * @c poll.h, @c pthread.h, @c sys/socket.h, @c sys/un.h, and @c unistd.h
+ * headers, the Wayland client header @c wayland-client.h (for its
+ * declarations alone), and Primrose.
+ * @since v0.0.0.66
+ *
+ * @remark Requests are written straight into one preallocated buffer, which
+ * only reaches the socket when flushed or full; nothing is allocated per
+ * request, and the objects made every frame reuse those destroyed before them.
+ * Events are queued as they arrived on the wire, and decoded only when
+ * dispatched.
+ *
+ * @remark Listeners are called with every argument widened to a machine word.
+ * This is only sound on calling conventions that pass integers and pointers
+ * alike, in registers and then eight-byte stack slots, like those of x64 and
+ * ARM64 Linux; the protocol has no floating-point arguments to upset this.
+ * Building for anything else is refused outright.
+ *
+ * @note This file contains material (the contents of the core Wayland
+ * protocol) copyrighted by the following people. All rights are reserved to
+ * their proper owners.
+ * Copyright © 2008-2011 Kristian Høgsberg
+ * Copyright © 2010-2011 Intel Corporation
+ * Copyright © 2012-2013 Collabora, Ltd.
+ *
+ * @copyright (c) 2025 - the Waterlily Project
+ * This source file is under the GNU General Public License v3.0. For licensing
+ * and other information, see the @c LICENSE.md file that should have come with
+ * your copy of the source code, or https://www.gnu.org/licenses/gpl-3.0.txt.
+ */
+
+#define _GNU_SOURCE
+
+#include <Primrose.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <wayland-client.h>
+
+// Listeners are called as though every argument were a word; see the file's
+// remarks. Anywhere else, that's simply wrong, so refuse to build at all.
+#if !defined(__linux__) || defined(__ILP32__) ||                               \
+    !(defined(__x86_64__) || defined(__aarch64__))
+#error "Wire.c only supports x64 and ARM64 Linux."
+#endif
+
+/**
+ * @def WIRE_MESSAGE
+ * @brief The largest message the protocol allows, in bytes.
+ * @since v0.0.0.66
+ */
+#define WIRE_MESSAGE 4096
+
+/**
+ * @def WIRE_FDS
+ * @brief The most file descriptors sent or received alongside one chunk of
+ * data.
+ * @since v0.0.0.66
+ */
+#define WIRE_FDS 28
+
+/**
+ * @def WIRE_ARGS
+ * @brief The most arguments an event or request may carry. The largest event
+ * we know of, @c wl_output.geometry, has eight; no request has as many.
+ * @since v0.0.0.66
+ */
+#define WIRE_ARGS 8
+
+/**
+ * @def WIRE_SPARES
+ * @brief The most destroyed proxies kept around to be reused. Every frame
+ * makes and destroys a callback, and often presentation feedback, so these
+ * spare the allocator entirely once the first few frames are out.
+ * @since v0.0.0.69
+ */
+#define WIRE_SPARES 8
+
+/**
+ * @def WIRE_TYPES
+ * @brief The characters of a message's signature that stand for an argument.
+ * @since v0.0.0.69
+ */
+#define WIRE_TYPES "iufonsah"
+
+/**
+ * @var const struct wl_interface wl_display_interface
+ * @brief The core global object, which is always object one.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_display_interface = {
+    .name = "wl_display",
+    .version = 1,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"sync", "n", nullptr},
+            {"get_registry", "n", nullptr},
+        },
+    .event_count = 2,
+    .events =
+        (struct wl_message[]){
+            {"error", "ous", nullptr},
+            {"delete_id", "u", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_registry_interface
+ * @brief The global registry object.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_registry_interface = {
+    .name = "wl_registry",
+    .version = 1,
+    .method_count = 1,
+    .methods =
+        (struct wl_message[]){
+            {"bind", "usun", nullptr},
+        },
+    .event_count = 2,
+    .events =
+        (struct wl_message[]){
+            {"global", "usu", nullptr},
+            {"global_remove", "u", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_callback_interface
+ * @brief The callback object, fired once.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_callback_interface = {
+    .name = "wl_callback",
+    .version = 1,
+    .method_count = 0,
+    .methods = nullptr,
+    .event_count = 1,
+    .events =
+        (struct wl_message[]){
+            {"done", "u", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_compositor_interface
+ * @brief The compositor singleton.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_compositor_interface = {
+    .name = "wl_compositor",
+    .version = 6,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"create_surface", "n", nullptr},
+            {"create_region", "n", nullptr},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface wl_shm_pool_interface
+ * @brief A shared memory pool.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_shm_pool_interface = {
+    .name = "wl_shm_pool",
+    .version = 2,
+    .method_count = 3,
+    .methods =
+        (struct wl_message[]){
+            {"create_buffer", "niiiiu", nullptr},
+            {"destroy", "", nullptr},
+            {"resize", "i", nullptr},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface wl_shm_interface
+ * @brief The shared memory support object.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_shm_interface = {
+    .name = "wl_shm",
+    .version = 2,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"create_pool", "nhi", nullptr},
+            {"release", "2", nullptr},
+        },
+    .event_count = 1,
+    .events =
+        (struct wl_message[]){
+            {"format", "u", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_buffer_interface
+ * @brief The content of a surface.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_buffer_interface = {
+    .name = "wl_buffer",
+    .version = 1,
+    .method_count = 1,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+        },
+    .event_count = 1,
+    .events =
+        (struct wl_message[]){
+            {"release", "", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_surface_interface
+ * @brief An onscreen surface.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_surface_interface = {
+    .name = "wl_surface",
+    .version = 6,
+    .method_count = 11,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"attach", "?oii", nullptr},
+            {"damage", "iiii", nullptr},
+            {"frame", "n", nullptr},
+            {"set_opaque_region", "?o", nullptr},
+            {"set_input_region", "?o", nullptr},
+            {"commit", "", nullptr},
+            {"set_buffer_transform", "2i", nullptr},
+            {"set_buffer_scale", "3i", nullptr},
+            {"damage_buffer", "4iiii", nullptr},
+            {"offset", "5ii", nullptr},
+        },
+    .event_count = 4,
+    .events =
+        (struct wl_message[]){
+            {"enter", "o", nullptr},
+            {"leave", "o", nullptr},
+            {"preferred_buffer_scale", "6i", nullptr},
+            {"preferred_buffer_transform", "6u", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_region_interface
+ * @brief A region of a surface.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_region_interface = {
+    .name = "wl_region",
+    .version = 1,
+    .method_count = 3,
+    .methods =
+        (struct wl_message[]){
+            {"destroy", "", nullptr},
+            {"add", "iiii", nullptr},
+            {"subtract", "iiii", nullptr},
+        },
+    .event_count = 0,
+    .events = nullptr,
+};
+
+/**
+ * @var const struct wl_interface wl_seat_interface
+ * @brief A group of input devices.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_seat_interface = {
+    .name = "wl_seat",
+    .version = 9,
+    .method_count = 4,
+    .methods =
+        (struct wl_message[]){
+            {"get_pointer", "n", nullptr},
+            {"get_keyboard", "n", nullptr},
+            {"get_touch", "n", nullptr},
+            {"release", "5", nullptr},
+        },
+    .event_count = 2,
+    .events =
+        (struct wl_message[]){
+            {"capabilities", "u", nullptr},
+            {"name", "2s", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_pointer_interface
+ * @brief A pointer input device.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_pointer_interface = {
+    .name = "wl_pointer",
+    .version = 9,
+    .method_count = 2,
+    .methods =
+        (struct wl_message[]){
+            {"set_cursor", "u?oii", nullptr},
+            {"release", "3", nullptr},
+        },
+    .event_count = 11,
+    .events =
+        (struct wl_message[]){
+            {"enter", "uoff", nullptr},
+            {"leave", "uo", nullptr},
+            {"motion", "uff", nullptr},
+            {"button", "uuuu", nullptr},
+            {"axis", "uuf", nullptr},
+            {"frame", "5", nullptr},
+            {"axis_source", "5u", nullptr},
+            {"axis_stop", "5uu", nullptr},
+            {"axis_discrete", "5ui", nullptr},
+            {"axis_value120", "8ui", nullptr},
+            {"axis_relative_direction", "9uu", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_keyboard_interface
+ * @brief A keyboard input device.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_keyboard_interface = {
+    .name = "wl_keyboard",
+    .version = 9,
+    .method_count = 1,
+    .methods =
+        (struct wl_message[]){
+            {"release", "3", nullptr},
+        },
+    .event_count = 6,
+    .events =
+        (struct wl_message[]){
+            {"keymap", "uhu", nullptr},
+            {"enter", "uoa", nullptr},
+            {"leave", "uo", nullptr},
+            {"key", "uuuu", nullptr},
+            {"modifiers", "uuuuu", nullptr},
+            {"repeat_info", "4ii", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_touch_interface
+ * @brief A touchscreen input device.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_touch_interface = {
+    .name = "wl_touch",
+    .version = 9,
+    .method_count = 1,
+    .methods =
+        (struct wl_message[]){
+            {"release", "3", nullptr},
+        },
+    .event_count = 7,
+    .events =
+        (struct wl_message[]){
+            {"down", "uuoiff", nullptr},
+            {"up", "uui", nullptr},
+            {"motion", "uiff", nullptr},
+            {"frame", "", nullptr},
+            {"cancel", "", nullptr},
+            {"shape", "6iff", nullptr},
+            {"orientation", "6if", nullptr},
+        },
+};
+
+/**
+ * @var const struct wl_interface wl_output_interface
+ * @brief A compositor output.
+ * @since v0.0.0.66
+ */
+const struct wl_interface wl_output_interface = {
+    .name = "wl_output",
+    .version = 4,
+    .method_count = 1,
+    .methods =
+        (struct wl_message[]){
+            {"release", "3", nullptr},
+        },
+    .event_count = 6,
+    .events =
+        (struct wl_message[]){
+            {"geometry", "iiiiissi", nullptr},
+            {"mode", "uiii", nullptr},
+            {"done", "2", nullptr},
+            {"scale", "2i", nullptr},
+            {"name", "4s", nullptr},
+            {"description", "4s", nullptr},
+        },
+};
+
+/**
+ * @struct wl_event_queue Wire.c "Source/Wire.c"
+ * @brief A queue of events waiting to be dispatched. Each record is three
+ * words (the size of the message in bytes, its number of file descriptors,
+ * and the generation of its object) followed by the file descriptors and the
+ * message itself, as it came off the wire.
+ * @since v0.0.0.66
+ */
+struct wl_event_queue
+{
+    /**
+     * @property display
+     * @brief The display this queue belongs to.
+     * @since v0.0.0.66
+     */
+    struct wl_display *display;
+    /**
+     * @property records
+     * @brief The storage of the queue, grown as needed and never shrunk.
+     * @since v0.0.0.66
+     */
+    uint32_t *records;
+    /**
+     * @property head
+     * @brief The word the oldest record starts at.
+     * @since v0.0.0.66
+     */
+    size_t head;
+    /**
+     * @property tail
+     * @brief The word past the newest record.
+     * @since v0.0.0.66
+     */
+    size_t tail;
+    /**
+     * @property capacity
+     * @brief The number of words in the storage.
+     * @since v0.0.0.66
+     */
+    size_t capacity;
+};
+
+/**
+ * @struct wl_proxy Wire.c "Source/Wire.c"
+ * @brief The client side of a protocol object.
+ * @since v0.0.0.66
+ */
+struct wl_proxy
+{
+    /**
+     * @property interface
+     * @brief What the object is.
+     * @since v0.0.0.66
+     */
+    const struct wl_interface *interface;
+    /**
+     * @property implementation
+     * @brief The listener of the object, or @c nullptr for none yet.
+     * @since v0.0.0.66
+     */
+    const void *implementation;
+    /**
+     * @property data
+     * @brief The user data handed to the listener.
+     * @since v0.0.0.66
+     */
+    void *data;
+    /**
+     * @property display
+     * @brief The display the object lives on.
+     * @since v0.0.0.66
+     */
+    struct wl_display *display;
+    /**
+     * @property queue
+     * @brief The queue the object's events go to.
+     * @since v0.0.0.66
+     */
+    struct wl_event_queue *queue;
+    /**
+     * @property id
+     * @brief The identifier of the object on the wire.
+     * @since v0.0.0.66
+     */
+    uint32_t id;
+    /**
+     * @property version
+     * @brief The version the object was made with.
+     * @since v0.0.0.66
+     */
+    uint32_t version;
+};
+
+/**
+ * @struct object Wire.c "Source/Wire.c"
+ * @brief A single slot of the object table. A slot with an interface but no
+ * proxy has been destroyed by us, but not yet by the compositor; events can
+ * still arrive for it, and must be skipped.
+ * @since v0.0.0.66
+ */
+struct object
+{
+    /**
+     * @property proxy
+     * @brief The live object, if any.
+     * @since v0.0.0.66
+     */
+    struct wl_proxy *proxy;
+    /**
+     * @property interface
+     * @brief What the object is, or @c nullptr if the slot is free.
+     * @since v0.0.0.66
+     */
+    const struct wl_interface *interface;
+    /**
+     * @property generation
+     * @brief The number of times this slot has been filled, so events queued
+     * for a previous tenant are never handed to the next.
+     * @since v0.0.0.66
+     */
+    uint32_t generation;
+    /**
+     * @property deleted
+     * @brief Whether or not the compositor has already let go of the
+     * identifier, so the slot is freed the moment we destroy the proxy.
+     * @since v0.0.0.66
+     */
+    bool deleted;
+};
+
+/**
+ * @struct wl_display Wire.c "Source/Wire.c"
+ * @brief The connection to the compositor. This begins with the proxy of the
+ * display object, since the protocol helpers cast between the two.
+ * @since v0.0.0.66
+ */
+struct wl_display
+{
+    /**
+     * @property proxy
+     * @brief The display object itself.
+     * @since v0.0.0.66
+     */
+    struct wl_proxy proxy;
+    /**
+     * @property queue
+     * @brief The default event queue.
+     * @since v0.0.0.66
+     */
+    struct wl_event_queue queue;
+    /**
+     * @property lock
+     * @brief The lock over everything below, and every queue.
+     * @since v0.0.0.66
+     */
+    pthread_mutex_t lock;
+    /**
+     * @property read
+     * @brief Signalled whenever a round of reading has ended.
+     * @since v0.0.0.66
+     */
+    pthread_cond_t read;
+    /**
+     * @property objects
+     * @brief The object table, indexed by identifier.
+     * @since v0.0.0.66
+     */
+    struct object *objects;
+    /**
+     * @property objectCount
+     * @brief The number of slots in the object table.
+     * @since v0.0.0.66
+     */
+    uint32_t objectCount;
+    /**
+     * @property vacant
+     * @brief The lowest slot of the object table that might be free; every
+     * slot below it is taken.
+     * @since v0.0.0.69
+     */
+    uint32_t vacant;
+    /**
+     * @property spareCount
+     * @brief The number of proxies kept to be reused.
+     * @since v0.0.0.69
+     */
+    uint32_t spareCount;
+    /**
+     * @property spares
+     * @brief Destroyed proxies, kept to be reused by the next objects made.
+     * @since v0.0.0.69
+     */
+    struct wl_proxy *spares[WIRE_SPARES];
+    /**
+     * @property readers
+     * @brief The number of threads that have prepared to read. The last one
+     * to arrive does the reading for all of them.
+     * @since v0.0.0.66
+     */
+    uint32_t readers;
+    /**
+     * @property serial
+     * @brief The number of rounds of reading so far.
+     * @since v0.0.0.66
+     */
+    uint32_t serial;
+    /**
+     * @property fd
+     * @brief The socket.
+     * @since v0.0.0.66
+     */
+    int fd;
+    /**
+     * @property error
+     * @brief The error that killed the connection, or zero if it lives.
+     * @since v0.0.0.66
+     */
+    int error;
+    /**
+     * @property outLength
+     * @brief The number of bytes waiting to be sent.
+     * @since v0.0.0.66
+     */
+    size_t outLength;
+    /**
+     * @property outFDCount
+     * @brief The number of file descriptors waiting to be sent.
+     * @since v0.0.0.66
+     */
+    size_t outFDCount;
+    /**
+     * @property inLength
+     * @brief The number of bytes received but not yet queued.
+     * @since v0.0.0.66
+     */
+    size_t inLength;
+    /**
+     * @property inFDCount
+     * @brief The number of file descriptors received but not yet queued.
+     * @since v0.0.0.66
+     */
+    size_t inFDCount;
+    /**
+     * @property outFDs
+     * @brief The file descriptors waiting to be sent. These are our own
+     * duplicates, closed once sent.
+     * @since v0.0.0.66
+     */
+    int outFDs[WIRE_FDS];
+    /**
+     * @property inFDs
+     * @brief The file descriptors received but not yet queued, in order.
+     * @since v0.0.0.66
+     */
+    int inFDs[WIRE_FDS * 2];
+    /**
+     * @property out
+     * @brief The requests waiting to be sent. This is kept in bytes, since a
+     * send may stop short in the middle of a word.
+     * @since v0.0.0.66
+     */
+    uint8_t out[WIRE_MESSAGE * 4];
+    /**
+     * @property in
+     * @brief The bytes received but not yet queued. Whole messages are always
+     * moved out from the front, so each starts on a word.
+     * @since v0.0.0.66
+     */
+    uint32_t in[WIRE_MESSAGE];
+};
+
+/**
+ * @fn void fail(struct wl_display *display, int error)
+ * @brief Kill the connection, keeping the first error that did so.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] error The error, as an @c errno value.
+ */
+static void fail(struct wl_display *display, int error)
+{
+    if (display->error == 0) display->error = error;
+}
+
+/**
+ * @fn void freeSlot(struct wl_display *display, uint32_t id, bool deleted)
+ * @brief Let go of one side of a slot of the object table. The slot is only
+ * free once both we and the compositor are done with it. The display must be
+ * locked.
+ * @since v0.0.0.69
+ *
+ * @param[in] display The display.
+ * @param[in] id The identifier of the slot.
+ * @param[in] deleted Whether the compositor deleted the identifier, rather
+ * than us destroying the proxy.
+ */
+static void freeSlot(struct wl_display *display, uint32_t id, bool deleted)
+{
+    struct object *object = &display->objects[id];
+    if (deleted) object->deleted = true;
+    else object->proxy = nullptr;
+    if (object->proxy != nullptr || !object->deleted) return;
+
+    object->interface = nullptr;
+    if (id < display->vacant) display->vacant = id;
+}
+
+/**
+ * @fn struct wl_proxy *createProxy(struct wl_display *display, const struct
+ * wl_interface *interface, uint32_t version, struct wl_event_queue *queue)
+ * @brief Make a new object, in the lowest free slot of the object table; the
+ * compositor refuses identifiers that skip ahead. The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] interface What the object is.
+ * @param[in] version The version of the object.
+ * @param[in] queue The queue the object's events go to.
+ * @return The object, or @c nullptr if it could not be allocated.
+ */
+static struct wl_proxy *createProxy(struct wl_display *display,
+                                    const struct wl_interface *interface,
+                                    uint32_t version,
+                                    struct wl_event_queue *queue)
+{
+    uint32_t id = display->vacant;
+    while (id < display->objectCount &&
+           display->objects[id].interface != nullptr)
+        id++;
+
+    if (id == display->objectCount)
+    {
+        struct object *objects = realloc(
+            display->objects, sizeof(struct object) * display->objectCount * 2);
+        if (__builtin_expect(objects == nullptr, false)) return nullptr;
+        memset(&objects[id], 0, sizeof(struct object) * display->objectCount);
+        display->objects = objects;
+        display->objectCount *= 2;
+    }
+
+    struct wl_proxy *proxy = display->spareCount != 0
+                                 ? display->spares[--display->spareCount]
+                                 : malloc(sizeof(struct wl_proxy));
+    if (__builtin_expect(proxy == nullptr, false)) return nullptr;
+    *proxy = (struct wl_proxy){.interface = interface,
+                               .display = display,
+                               .queue = queue,
+                               .id = id,
+                               .version = version};
+
+    struct object *object = &display->objects[id];
+    object->proxy = proxy;
+    object->interface = interface;
+    object->generation++;
+    object->deleted = false;
+    display->vacant = id + 1;
+    return proxy;
+}
+
+/**
+ * @fn void destroyProxy(struct wl_proxy *proxy)
+ * @brief Destroy an object on our side. Its slot stays taken until the
+ * compositor deletes the identifier too. The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] proxy The object.
+ */
+static void destroyProxy(struct wl_proxy *proxy)
+{
+    struct wl_display *display = proxy->display;
+    freeSlot(display, proxy->id, false);
+    if (display->spareCount < WIRE_SPARES)
+        display->spares[display->spareCount++] = proxy;
+    else free(proxy);
+}
+
+/**
+ * @fn int sendOut(struct wl_display *display)
+ * @brief Send as much of what's waiting as the socket takes, in one @c
+ * sendmsg. Every file descriptor waiting goes along with the first byte sent.
+ * The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @return Zero, or -1 with @c errno set; @c EAGAIN if the socket is full.
+ */
+static int sendOut(struct wl_display *display)
+{
+    union
+    {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int) * WIRE_FDS)];
+    } control;
+    struct iovec data = {display->out, display->outLength};
+    struct msghdr message = {.msg_iov = &data, .msg_iovlen = 1};
+    if (display->outFDCount != 0)
+    {
+        size_t size = sizeof(int) * display->outFDCount;
+        message.msg_control = control.buffer;
+        message.msg_controllen = CMSG_SPACE(size);
+
+        struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(size);
+        memcpy(CMSG_DATA(header), display->outFDs, size);
+    }
+
+    ssize_t sent;
+    do sent = sendmsg(display->fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+    while (sent == -1 && errno == EINTR);
+    if (sent == -1)
+    {
+        if (errno != EAGAIN) fail(display, errno);
+        return -1;
+    }
+
+    for (size_t i = 0; i < display->outFDCount; ++i)
+        (void)close(display->outFDs[i]);
+    display->outFDCount = 0;
+    display->outLength -= (size_t)sent;
+    memmove(display->out, display->out + sent, display->outLength);
+    return 0;
+}
+
+/**
+ * @fn int drain(struct wl_display *display)
+ * @brief Send everything that's waiting, sleeping until the socket is
+ * writable whenever it fills up. The display must be locked, though the lock
+ * is let go while sleeping, so anything read under it before must be read
+ * again after.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @return Zero, or -1 with @c errno set.
+ */
+static int drain(struct wl_display *display)
+{
+    while (display->outLength != 0)
+    {
+        if (sendOut(display) == 0) continue;
+        if (errno != EAGAIN) return -1;
+
+        // Nobody else should have to wait on the compositor with us.
+        struct pollfd fd = {.fd = display->fd, .events = POLLOUT};
+        (void)pthread_mutex_unlock(&display->lock);
+        int polled = poll(&fd, 1, -1), error = errno;
+        (void)pthread_mutex_lock(&display->lock);
+        if (polled == -1 && error != EINTR) fail(display, error);
+        if (display->error != 0)
+        {
+            errno = display->error;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @fn size_t put(uint32_t *message, size_t length, const void *data, size_t
+ * size)
+ * @brief Append a length-prefixed, word-padded blob to a message.
+ * @since v0.0.0.66
+ *
+ * @param[in] message The message.
+ * @param[in] length The length of the message so far, in words.
+ * @param[in] data The blob, which may be @c nullptr if @p size is zero.
+ * @param[in] size The size of the blob, in bytes.
+ * @return The new length of the message, or zero if it no longer fits.
+ */
+static size_t put(uint32_t *message, size_t length, const void *data,
+                  size_t size)
+{
+    size_t words = (size + 3) / 4;
+    if (length + 1 + words > WIRE_MESSAGE / 4) return 0;
+
+    message[length++] = (uint32_t)size;
+    if (words == 0) return length;
+    message[length + words - 1] = 0;
+    memcpy(&message[length], data, size);
+    return length + words;
+}
+
+struct wl_proxy *
+wl_proxy_marshal_array_flags(struct wl_proxy *proxy, uint32_t opcode,
+                             const struct wl_interface *interface,
+                             uint32_t version, uint32_t flags,
+                             union wl_argument *args)
+{
+    struct wl_display *display = proxy->display;
+    const char *signature = proxy->interface->methods[opcode].signature;
+    uint32_t message[WIRE_MESSAGE / 4];
+    int fds[WIRE_FDS];
+    size_t length = 2;
+    size_t fdCount = 0;
+    size_t newID = 0;
+    struct wl_proxy *created = nullptr;
+
+    (void)pthread_mutex_lock(&display->lock);
+    if (__builtin_expect(display->error != 0, false)) goto end;
+
+    size_t count = 0;
+    for (const char *c = signature; *c != '\0' && length != 0; ++c)
+    {
+        // Anything else marks nullability, or the version of an argument.
+        if (strchr(WIRE_TYPES, *c) == nullptr) continue;
+        if (length == WIRE_MESSAGE / 4 || count == WIRE_ARGS)
+        {
+            length = 0;
+            break;
+        }
+
+        union wl_argument *arg = &args[count++];
+        switch (*c)
+        {
+            case 'i':
+            case 'u':
+            case 'f': message[length++] = arg->u; break;
+            case 'o':
+            {
+                struct wl_proxy *object = (struct wl_proxy *)arg->o;
+                message[length++] = object == nullptr ? 0 : object->id;
+                break;
+            }
+            case 'n':
+                // Filled in once there's room; see below.
+                newID = length;
+                message[length++] = 0;
+                break;
+            case 's':
+            {
+                const char *string = arg->s;
+                length = put(message, length, string,
+                             string == nullptr ? 0 : strlen(string) + 1);
+                break;
+            }
+            case 'a':
+            {
+                struct wl_array *array = arg->a;
+                length = array == nullptr
+                             ? put(message, length, nullptr, 0)
+                             : put(message, length, array->data, array->size);
+                break;
+            }
+            case 'h':
+            {
+                // The caller keeps its descriptor; we send our own.
+                int fd = arg->h;
+                if (fdCount == WIRE_FDS ||
+                    (fds[fdCount] = fcntl(fd, F_DUPFD_CLOEXEC, 0)) == -1)
+                    length = 0;
+                else fdCount++;
+                break;
+            }
+            default: break;
+        }
+    }
+
+    if (__builtin_expect(length == 0, false))
+    {
+        primrose_log(ERROR, "Failed to marshal request '%s.%s'.",
+                     proxy->interface->name,
+                     proxy->interface->methods[opcode].name);
+        fail(display, EINVAL);
+    }
+    // Make room for the message, if the buffer's too full to take it. The new
+    // object is only made after, since the lock may have been let go, and
+    // identifiers must go out in the order they were handed out.
+    else if ((display->outLength + length * 4 <= sizeof(display->out) &&
+              display->outFDCount + fdCount <= WIRE_FDS) ||
+             drain(display) == 0)
+    {
+        if (interface != nullptr)
+            created = createProxy(display, interface, version, proxy->queue);
+        if (__builtin_expect(interface != nullptr && created == nullptr, false))
+            fail(display, ENOMEM);
+        else
+        {
+            if (created != nullptr && newID != 0) message[newID] = created->id;
+            message[0] = proxy->id;
+            message[1] = (uint32_t)(length * 4) << 16 | opcode;
+            memcpy(display->out + display->outLength, message, length * 4);
+            display->outLength += length * 4;
+            memcpy(&display->outFDs[display->outFDCount], fds,
+                   sizeof(int) * fdCount);
+            display->outFDCount += fdCount;
+            fdCount = 0;
+        }
+    }
+    for (size_t i = 0; i < fdCount; ++i) (void)close(fds[i]);
+
+end:
+    if (flags & WL_MARSHAL_FLAG_DESTROY) destroyProxy(proxy);
+    (void)pthread_mutex_unlock(&display->lock);
+    return created;
+}
+
+struct wl_proxy *wl_proxy_marshal_flags(struct wl_proxy *proxy,
+                                        uint32_t opcode,
+                                        const struct wl_interface *interface,
+                                        uint32_t version, uint32_t flags, ...)
+{
+    union wl_argument args[WIRE_ARGS];
+    size_t count = 0;
+
+    va_list list;
+    va_start(list, flags);
+    // Whatever doesn't fit is refused by the marshalling itself.
+    for (const char *c = proxy->interface->methods[opcode].signature;
+         *c != '\0' && count < WIRE_ARGS; ++c)
+    {
+        switch (*c)
+        {
+            case 'i':
+            case 'f':
+            case 'h': args[count++].i = va_arg(list, int32_t); break;
+            case 'u': args[count++].u = va_arg(list, uint32_t); break;
+            case 'o':
+                args[count++].o =
+                    (struct wl_object *)va_arg(list, struct wl_proxy *);
+                break;
+            case 'n':
+                (void)va_arg(list, void *);
+                args[count++].n = 0;
+                break;
+            case 's': args[count++].s = va_arg(list, const char *); break;
+            case 'a': args[count++].a = va_arg(list, struct wl_array *); break;
+            default: break;
+        }
+    }
+    va_end(list);
+
+    return wl_proxy_marshal_array_flags(proxy, opcode, interface, version,
+                                        flags, args);
+}
+
+int wl_proxy_add_listener(struct wl_proxy *proxy, void (**implementation)(void),
+                          void *data)
+{
+    if (__builtin_expect(proxy->implementation != nullptr, false))
+    {
+        primrose_log(ERROR, "Listener already set on '%s'.",
+                     proxy->interface->name);
+        return -1;
+    }
+
+    proxy->implementation = implementation;
+    proxy->data = data;
+    return 0;
+}
+
+uint32_t wl_proxy_get_version(struct wl_proxy *proxy) { return proxy->version; }
+
+void wl_proxy_destroy(struct wl_proxy *proxy)
+{
+    struct wl_display *display = proxy->display;
+    (void)pthread_mutex_lock(&display->lock);
+    destroyProxy(proxy);
+    (void)pthread_mutex_unlock(&display->lock);
+}
+
+void wl_proxy_set_queue(struct wl_proxy *proxy, struct wl_event_queue *queue)
+{
+    struct wl_display *display = proxy->display;
+    (void)pthread_mutex_lock(&display->lock);
+    proxy->queue = queue == nullptr ? &display->queue : queue;
+    (void)pthread_mutex_unlock(&display->lock);
+}
+
+/**
+ * @fn bool enqueue(struct wl_event_queue *queue, const uint32_t *message,
+ * uint32_t size, const int *fds, uint32_t fdCount, uint32_t generation)
+ * @brief Copy a message onto the end of a queue, growing it if needed. The
+ * display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] queue The queue.
+ * @param[in] message The message.
+ * @param[in] size The size of the message, in bytes.
+ * @param[in] fds The file descriptors of the message, whose ownership passes
+ * to the queue.
+ * @param[in] fdCount The number of file descriptors.
+ * @param[in] generation The generation of the message's object.
+ * @return Whether or not there was memory enough.
+ */
+static bool enqueue(struct wl_event_queue *queue, const uint32_t *message,
+                    uint32_t size, const int *fds, uint32_t fdCount,
+                    uint32_t generation)
+{
+    size_t words = 3 + fdCount + size / 4;
+    if (queue->tail + words > queue->capacity)
+    {
+        memmove(queue->records, queue->records + queue->head,
+                sizeof(uint32_t) * (queue->tail - queue->head));
+        queue->tail -= queue->head;
+        queue->head = 0;
+    }
+    if (queue->tail + words > queue->capacity)
+    {
+        size_t capacity = queue->capacity == 0 ? WIRE_MESSAGE : queue->capacity;
+        while (queue->tail + words > capacity) capacity *= 2;
+
+        uint32_t *records =
+            realloc(queue->records, sizeof(uint32_t) * capacity);
+        if (__builtin_expect(records == nullptr, false)) return false;
+        queue->records = records;
+        queue->capacity = capacity;
+    }
+
+    uint32_t *record = &queue->records[queue->tail];
+    record[0] = size;
+    record[1] = fdCount;
+    record[2] = generation;
+    memcpy(&record[3], fds, sizeof(int) * fdCount);
+    memcpy(&record[3 + fdCount], message, size);
+    queue->tail += words;
+    return true;
+}
+
+/**
+ * @fn void clearQueue(struct wl_event_queue *queue)
+ * @brief Throw away every record of a queue, closing their file descriptors,
+ * and free its storage. The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] queue The queue.
+ */
+static void clearQueue(struct wl_event_queue *queue)
+{
+    while (queue->head != queue->tail)
+    {
+        uint32_t *record = &queue->records[queue->head];
+        for (uint32_t i = 0; i < record[1]; ++i)
+            (void)close((int)record[3 + i]);
+        queue->head += 3 + record[1] + record[0] / 4;
+    }
+    free(queue->records);
+    *queue = (struct wl_event_queue){.display = queue->display};
+}
+
+/**
+ * @fn int displayEvent(struct wl_display *display, const uint32_t *message,
+ * uint32_t size)
+ * @brief Handle an event of the display object. These are handled as soon as
+ * they're read, since they concern the connection itself.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] message The message.
+ * @param[in] size The size of the message, in bytes.
+ * @return Zero, or -1 if the connection died.
+ */
+static int displayEvent(struct wl_display *display, const uint32_t *message,
+                        uint32_t size)
+{
+    uint32_t opcode = message[1] & 0xFFFF;
+    if (opcode == 0 && size >= 20)
+    {
+        uint32_t length = message[4];
+        const char *description = (const char *)&message[5];
+        if (length == 0 || length > size - 20 || description[length - 1] != 0)
+            description = "(malformed)";
+        primrose_log(ERROR, "Protocol error %u on object %u: %s", message[3],
+                     message[2], description);
+    }
+    else if (opcode == 1 && size >= 12)
+    {
+        uint32_t id = message[2];
+        if (id >= display->objectCount) return 0;
+
+        freeSlot(display, id, true);
+        return 0;
+    }
+    else primrose_log(ERROR, "Got malformed display event.");
+
+    fail(display, EPROTO);
+    return -1;
+}
+
+/**
+ * @fn int handle(struct wl_display *display, const uint32_t *message,
+ * uint32_t size)
+ * @brief Route a message just read to where it belongs, along with its file
+ * descriptors. The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] message The message.
+ * @param[in] size The size of the message, in bytes.
+ * @return Zero, or -1 if the connection died.
+ */
+static int handle(struct wl_display *display, const uint32_t *message,
+                  uint32_t size)
+{
+    uint32_t id = message[0];
+    uint32_t opcode = message[1] & 0xFFFF;
+    if (id == 1) return displayEvent(display, message, size);
+
+    struct object *object =
+        id < display->objectCount ? &display->objects[id] : nullptr;
+    if (__builtin_expect(object == nullptr || object->interface == nullptr ||
+                             opcode >= (uint32_t)object->interface->event_count,
+                         false))
+    {
+        primrose_log(ERROR, "Got event %u for unknown object %u.", opcode, id);
+        fail(display, EPROTO);
+        return -1;
+    }
+
+    uint32_t fdCount = 0;
+    for (const char *c = object->interface->events[opcode].signature;
+         *c != '\0'; ++c)
+        if (*c == 'h') fdCount++;
+    if (__builtin_expect(fdCount > display->inFDCount || fdCount > WIRE_ARGS,
+                         false))
+    {
+        primrose_log(ERROR, "Got event without its file descriptors.");
+        fail(display, EPROTO);
+        return -1;
+    }
+
+    if (object->proxy == nullptr ||
+        !enqueue(object->proxy->queue, message, size, display->inFDs, fdCount,
+                 object->generation))
+        for (uint32_t i = 0; i < fdCount; ++i) (void)close(display->inFDs[i]);
+
+    display->inFDCount -= fdCount;
+    memmove(display->inFDs, &display->inFDs[fdCount],
+            sizeof(int) * display->inFDCount);
+    return 0;
+}
+
+/**
+ * @fn int readEvents(struct wl_display *display)
+ * @brief Read whatever the socket holds, without waiting, and queue every
+ * whole message. The display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @return Zero, or -1 if the connection died.
+ */
+static int readEvents(struct wl_display *display)
+{
+    union
+    {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int) * WIRE_FDS)];
+    } control;
+    struct iovec data = {(uint8_t *)display->in + display->inLength,
+                         sizeof(display->in) - display->inLength};
+    struct msghdr message = {.msg_iov = &data,
+                             .msg_iovlen = 1,
+                             .msg_control = control.buffer,
+                             .msg_controllen = sizeof(control.buffer)};
+
+    ssize_t got;
+    do got = recvmsg(display->fd, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    while (got == -1 && errno == EINTR);
+    if (got == -1 && errno == EAGAIN) return 0;
+    if (got <= 0)
+    {
+        fail(display, got == 0 ? EPIPE : errno);
+        return -1;
+    }
+
+    for (struct cmsghdr *header = CMSG_FIRSTHDR(&message); header != nullptr;
+         header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level != SOL_SOCKET ||
+            header->cmsg_type != SCM_RIGHTS)
+            continue;
+
+        size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        int *fds = (int *)CMSG_DATA(header);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (display->inFDCount < WIRE_FDS * 2)
+                display->inFDs[display->inFDCount++] = fds[i];
+            else
+            {
+                (void)close(fds[i]);
+                fail(display, EPROTO);
+            }
+        }
+    }
+    // The kernel has dropped whatever descriptors didn't fit, so the events
+    // that carried them can never be made sense of.
+    if (__builtin_expect((message.msg_flags & MSG_CTRUNC) != 0, false))
+    {
+        primrose_log(ERROR, "Got more file descriptors than fit.");
+        fail(display, EPROTO);
+        return -1;
+    }
+    display->inLength += (size_t)got;
+
+    size_t offset = 0;
+    while (display->error == 0 && display->inLength - offset >= 8)
+    {
+        const uint32_t *header = &display->in[offset / 4];
+        uint32_t size = header[1] >> 16;
+        // Anything larger could never be queued, let alone dispatched.
+        if (__builtin_expect(size < 8 || size % 4 != 0 || size > WIRE_MESSAGE,
+                             false))
+        {
+            primrose_log(ERROR, "Got malformed message header.");
+            fail(display, EPROTO);
+            break;
+        }
+        if (display->inLength - offset < size) break;
+
+        (void)handle(display, header, size);
+        offset += size;
+    }
+    display->inLength -= offset;
+    memmove(display->in, (uint8_t *)display->in + offset, display->inLength);
+    return display->error == 0 ? 0 : -1;
+}
+
+/**
+ * @fn void (*decode(struct wl_display *display, const uint32_t *record,
+ * uintptr_t *args, struct wl_array *arrays, struct wl_proxy **proxy))(void)
+ * @brief Turn a queued record back into the arguments of its listener. The
+ * display must be locked.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] record The record.
+ * @param[out] args The arguments, each widened to a word.
+ * @param[out] arrays The storage of any array arguments, which point into the
+ * record.
+ * @param[out] proxy The object the event is for.
+ * @return The listener to call, or @c nullptr if there is none, the object is
+ * gone, or the record is malformed.
+ */
+static void (*decode(struct wl_display *display, const uint32_t *record,
+                     uintptr_t *args, struct wl_array *arrays,
+                     struct wl_proxy **proxy))(void)
+{
+    const int *fds = (const int *)&record[3];
+    const uint32_t *message = &record[3 + record[1]];
+    size_t end = record[0] / 4;
+    uint32_t opcode = message[1] & 0xFFFF;
+
+    struct object *object = &display->objects[message[0]];
+    if (object->proxy == nullptr || object->generation != record[2])
+        return nullptr;
+    *proxy = object->proxy;
+
+    size_t at = 2;
+    size_t arg = 0;
+    size_t fd = 0;
+    for (const char *c = object->interface->events[opcode].signature;
+         *c != '\0'; ++c)
+    {
+        if (*c == '?' || (*c >= '0' && *c <= '9')) continue;
+        if (arg == WIRE_ARGS || (*c != 'h' && at == end)) goto malformed;
+
+        switch (*c)
+        {
+            case 'i':
+            case 'f': args[arg] = (uintptr_t)(int32_t)message[at++]; break;
+            case 'u': args[arg] = message[at++]; break;
+            case 'h': args[arg] = (uintptr_t)fds[fd++]; break;
+            case 'o':
+            {
+                uint32_t id = message[at++];
+                args[arg] = id < display->objectCount
+                                ? (uintptr_t)display->objects[id].proxy
+                                : 0;
+                break;
+            }
+            case 's':
+            case 'a':
+            {
+                uint32_t size = message[at++];
+                size_t words = (size + 3) / 4;
+                if (words > end - at) goto malformed;
+
+                const char *data = (const char *)&message[at];
+                at += words;
+                if (*c == 'a')
+                {
+                    arrays[arg] = (struct wl_array){
+                        .size = size, .alloc = size, .data = (void *)data};
+                    args[arg] = (uintptr_t)&arrays[arg];
+                }
+                else if (size == 0) args[arg] = 0;
+                else if (data[size - 1] != '\0') goto malformed;
+                else args[arg] = (uintptr_t)data;
+                break;
+            }
+            // Objects made by the compositor aren't part of any protocol we
+            // bind.
+            default: goto malformed;
+        }
+        arg++;
+    }
+
+    if ((*proxy)->implementation == nullptr) return nullptr;
+    return ((void (*const *)(void))(*proxy)->implementation)[opcode];
+
+malformed:
+    primrose_log(ERROR, "Got malformed event %u for '%s'.", opcode,
+                 object->interface->name);
+    fail(display, EPROTO);
+    return nullptr;
+}
+
+int wl_display_dispatch_queue_pending(struct wl_display *display,
+                                      struct wl_event_queue *queue)
+{
+    typedef void (*handler)(void *, struct wl_proxy *, uintptr_t, uintptr_t,
+                            uintptr_t, uintptr_t, uintptr_t, uintptr_t,
+                            uintptr_t, uintptr_t);
+    uint32_t record[3 + WIRE_ARGS + WIRE_MESSAGE / 4];
+    int count = 0;
+
+    (void)pthread_mutex_lock(&display->lock);
+    while (display->error == 0 && queue->head != queue->tail)
+    {
+        const uint32_t *next = &queue->records[queue->head];
+        size_t words = 3 + next[1] + next[0] / 4;
+        memcpy(record, next, sizeof(uint32_t) * words);
+        queue->head += words;
+        if (queue->head == queue->tail) queue->head = queue->tail = 0;
+
+        uintptr_t args[WIRE_ARGS] = {0};
+        struct wl_array arrays[WIRE_ARGS];
+        struct wl_proxy *proxy = nullptr;
+        handler listener =
+            (handler)decode(display, record, args, arrays, &proxy);
+        if (listener == nullptr)
+        {
+            for (uint32_t i = 0; i < record[1]; ++i)
+                (void)close((int)record[3 + i]);
+            continue;
+        }
+
+        // Listeners are free to send requests, or destroy their object.
+        (void)pthread_mutex_unlock(&display->lock);
+        listener(proxy->data, proxy, args[0], args[1], args[2], args[3],
+                 args[4], args[5], args[6], args[7]);
+        (void)pthread_mutex_lock(&display->lock);
+        count++;
+    }
+    int error = display->error;
+    (void)pthread_mutex_unlock(&display->lock);
+
+    if (__builtin_expect(error == 0, true)) return count;
+    errno = error;
+    return -1;
+}
+
+int wl_display_dispatch_pending(struct wl_display *display)
+{
+    return wl_display_dispatch_queue_pending(display, &display->queue);
+}
+
+int wl_display_prepare_read_queue(struct wl_display *display,
+                                  struct wl_event_queue *queue)
+{
+    int result = 0;
+    (void)pthread_mutex_lock(&display->lock);
+    if (__builtin_expect(display->error != 0, false))
+    {
+        errno = display->error;
+        result = -1;
+    }
+    else if (queue->head != queue->tail)
+    {
+        errno = EAGAIN;
+        result = -1;
+    }
+    else display->readers++;
+    (void)pthread_mutex_unlock(&display->lock);
+    return result;
+}
+
+int wl_display_prepare_read(struct wl_display *display)
+{
+    return wl_display_prepare_read_queue(display, &display->queue);
+}
+
+void wl_display_cancel_read(struct wl_display *display)
+{
+    (void)pthread_mutex_lock(&display->lock);
+    if (--display->readers == 0)
+    {
+        display->serial++;
+        (void)pthread_cond_broadcast(&display->read);
+    }
+    (void)pthread_mutex_unlock(&display->lock);
+}
+
+int wl_display_read_events(struct wl_display *display)
+{
+    (void)pthread_mutex_lock(&display->lock);
+    if (--display->readers == 0)
+    {
+        if (display->error == 0) (void)readEvents(display);
+        display->serial++;
+        (void)pthread_cond_broadcast(&display->read);
+    }
+    else
+    {
+        // Someone else is yet to read; they'll do it for us.
+        uint32_t serial = display->serial;
+        while (display->serial == serial)
+            (void)pthread_cond_wait(&display->read, &display->lock);
+    }
+    int error = display->error;
+    (void)pthread_mutex_unlock(&display->lock);
+
+    if (__builtin_expect(error == 0, true)) return 0;
+    errno = error;
+    return -1;
+}
+
+int wl_display_flush(struct wl_display *display)
+{
+    int result = 0;
+    (void)pthread_mutex_lock(&display->lock);
+    if (__builtin_expect(display->error != 0, false))
+    {
+        errno = display->error;
+        result = -1;
+    }
+    else
+        while (display->outLength != 0 && result == 0)
+            result = sendOut(display);
+    (void)pthread_mutex_unlock(&display->lock);
+    return result;
+}
+
+/**
+ * @fn int dispatch(struct wl_display *display, struct wl_event_queue *queue)
+ * @brief Dispatch a queue, first waiting for events to arrive if it's empty.
+ * @since v0.0.0.66
+ *
+ * @param[in] display The display.
+ * @param[in] queue The queue.
+ * @return The number of events dispatched, or -1 if the connection died.
+ */
+static int dispatch(struct wl_display *display, struct wl_event_queue *queue)
+{
+    if (wl_display_prepare_read_queue(display, queue) == -1)
+        return errno == EAGAIN
+                   ? wl_display_dispatch_queue_pending(display, queue)
+                   : -1;
+
+    (void)pthread_mutex_lock(&display->lock);
+    int result = drain(display);
+    (void)pthread_mutex_unlock(&display->lock);
+
+    struct pollfd fd = {.fd = display->fd, .events = POLLIN};
+    while (result == 0 && (result = poll(&fd, 1, -1)) == -1 && errno == EINTR)
+        result = 0;
+    if (__builtin_expect(result == -1, false))
+    {
+        wl_display_cancel_read(display);
+        return -1;
+    }
+
+    if (__builtin_expect(wl_display_read_events(display) == -1, false))
+        return -1;
+    return wl_display_dispatch_queue_pending(display, queue);
+}
+
+/**
+ * @copydoc wl_callback_listener::done
+ */
+static void roundtripDone(void *data, struct wl_callback *callback, uint32_t)
+{
+    *(bool *)data = true;
+    wl_proxy_destroy((struct wl_proxy *)callback);
+}
+
+/**
+ * @var struct wl_callback_listener pRoundtripListener
+ * @brief The listener for the callback of a roundtrip.
+ * @since v0.0.0.66
+ */
+static const struct wl_callback_listener pRoundtripListener = {&roundtripDone};
+
+int wl_display_roundtrip(struct wl_display *display)
+{
+    bool done = false;
+    struct wl_callback *callback = wl_display_sync(display);
+    if (__builtin_expect(callback == nullptr, false)) return -1;
+    (void)wl_callback_add_listener(callback, &pRoundtripListener, &done);
+
+    int total = 0;
+    while (!done)
+    {
+        int count = dispatch(display, &display->queue);
+        if (__builtin_expect(count == -1, false)) return -1;
+        total += count;
+    }
+    return total;
+}
+
+struct wl_event_queue *wl_display_create_queue(struct wl_display *display)
+{
+    struct wl_event_queue *queue = malloc(sizeof(struct wl_event_queue));
+    if (__builtin_expect(queue != nullptr, true))
+        *queue = (struct wl_event_queue){.display = display};
+    return queue;
+}
+
+void wl_event_queue_destroy(struct wl_event_queue *queue)
+{
+    struct wl_display *display = queue->display;
+    (void)pthread_mutex_lock(&display->lock);
+    // Stragglers fall back to the default queue rather than dangle.
+    for (uint32_t i = 2; i < display->objectCount; ++i)
+        if (display->objects[i].proxy != nullptr &&
+            display->objects[i].proxy->queue == queue)
+            display->objects[i].proxy->queue = &display->queue;
+    clearQueue(queue);
+    (void)pthread_mutex_unlock(&display->lock);
+    free(queue);
+}
+
+int wl_display_get_fd(struct wl_display *display) { return display->fd; }
+
+/**
+ * @fn int connectSocket(const char *name)
+ * @brief Connect to the compositor's socket, found the same way the Wayland
+ * client library finds it.
+ * @since v0.0.0.66
+ *
+ * @param[in] name The name of the socket, or @c nullptr to use @c
+ * WAYLAND_DISPLAY, or failing that @c wayland-0. Relative names are looked up
+ * within @c XDG_RUNTIME_DIR.
+ * @return The socket, or -1 with @c errno set.
+ */
+static int connectSocket(const char *name)
+{
+    if (name == nullptr) name = getenv("WAYLAND_DISPLAY");
+    if (name == nullptr) name = "wayland-0";
+
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    int length;
+    if (name[0] == '/')
+        length = snprintf(address.sun_path, sizeof(address.sun_path), "%s",
+                          name);
+    else
+    {
+        const char *runtime = getenv("XDG_RUNTIME_DIR");
+        if (__builtin_expect(runtime == nullptr, false))
+        {
+            primrose_log(ERROR, "XDG_RUNTIME_DIR is not set.");
+            errno = ENOENT;
+            return -1;
+        }
+        length = snprintf(address.sun_path, sizeof(address.sun_path), "%s/%s",
+                          runtime, name);
+    }
+    if (__builtin_expect(length < 0 ||
+                             (size_t)length >= sizeof(address.sun_path),
+                         false))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (__builtin_expect(fd == -1, false)) return -1;
+    if (__builtin_expect(
+            connect(fd, (struct sockaddr *)&address,
+                    offsetof(struct sockaddr_un, sun_path) + (size_t)length +
+                        1) == -1,
+            false))
+    {
+        (void)close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct wl_display *wl_display_connect(const char *name)
+{
+    int fd;
+    const char *socketFD = getenv("WAYLAND_SOCKET");
+    if (name == nullptr && socketFD != nullptr)
+    {
+        // We've been handed a connection already.
+        char *end;
+        long value = strtol(socketFD, &end, 10);
+        (void)unsetenv("WAYLAND_SOCKET");
+        if (*end != '\0' || value < 0 || value > INT_MAX)
+        {
+            errno = EINVAL;
+            return nullptr;
+        }
+        fd = (int)value;
+        (void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    else fd = connectSocket(name);
+    if (__builtin_expect(fd == -1, false)) return nullptr;
+
+    struct wl_display *display = calloc(1, sizeof(struct wl_display));
+    struct object *objects = calloc(32, sizeof(struct object));
+    if (__builtin_expect(display == nullptr || objects == nullptr, false))
+    {
+        free(display);
+        free(objects);
+        (void)close(fd);
+        errno = ENOMEM;
+        return nullptr;
+    }
+
+    display->proxy = (struct wl_proxy){.interface = &wl_display_interface,
+                                       .display = display,
+                                       .queue = &display->queue,
+                                       .id = 1,
+                                       .version = 1};
+    display->queue.display = display;
+    display->objects = objects;
+    display->objectCount = 32;
+    display->vacant = 2;
+    display->objects[1] = (struct object){.proxy = &display->proxy,
+                                          .interface = &wl_display_interface,
+                                          .generation = 1};
+    display->fd = fd;
+    (void)pthread_mutex_init(&display->lock, nullptr);
+    (void)pthread_cond_init(&display->read, nullptr);
+    return display;
+}
+
+void wl_display_disconnect(struct wl_display *display)
+{
+    clearQueue(&display->queue);
+    for (size_t i = 0; i < display->outFDCount; ++i)
+        (void)close(display->outFDs[i]);
+    for (size_t i = 0; i < display->inFDCount; ++i)
+        (void)close(display->inFDs[i]);
+    (void)close(display->fd);
+
+    (void)pthread_cond_destroy(&display->read);
+    (void)pthread_mutex_destroy(&display->lock);
+    for (uint32_t i = 0; i < display->spareCount; ++i)
+        free(display->spares[i]);
+    free(display->objects);
+    free(display);
+}